@@ -0,0 +1,84 @@
+#include "AllocCounter.h"
+
+#include <new>
+#include <cstdlib>
+
+#ifdef LOOTTRACKER_COUNT_ALLOCATIONS
+
+// Plain counter: no constructor, so it is usable before anything else is set
+// up, including from allocations made during static initialisation.
+static thread_local uint64_t t_Allocations = 0;
+
+static void* Allocate(size_t size)
+{
+    ++t_Allocations;
+    return malloc(size ? size : 1);
+}
+
+static void* AllocateAligned(size_t size, size_t align)
+{
+    ++t_Allocations;
+    if (size == 0) size = 1;
+#ifdef _MSC_VER
+    return _aligned_malloc(size, align);
+#else
+    return aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+static void FreeAligned(void* p)
+{
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+void* operator new(size_t size)
+{
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept   { return Allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+
+void* operator new(size_t size, std::align_val_t align)
+{
+    if (void* p = AllocateAligned(size, (size_t)align)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t align)
+{
+    if (void* p = AllocateAligned(size, (size_t)align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept                          { free(p); }
+void operator delete[](void* p) noexcept                        { free(p); }
+void operator delete(void* p, size_t) noexcept                  { free(p); }
+void operator delete[](void* p, size_t) noexcept                { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept   { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete(void* p, std::align_val_t) noexcept          { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept        { FreeAligned(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept   { FreeAligned(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { FreeAligned(p); }
+
+bool     AllocCounter::Enabled()    { return true; }
+uint64_t AllocCounter::ThisThread() { return t_Allocations; }
+
+#else
+
+bool     AllocCounter::Enabled()    { return false; }
+uint64_t AllocCounter::ThisThread() { return 0; }
+
+#endif
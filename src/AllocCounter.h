@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+// ── Heap allocation counter ───────────────────────────────────────────────────
+// Built with LOOTTRACKER_COUNT_ALLOCATIONS, AllocCounter.cpp replaces the
+// global operator new / delete so every allocation the addon makes through
+// them (containers, strings, std::function, zlib's state) is counted against
+// the thread that made it.  Without it nothing is replaced and the counts
+// stay 0.  malloc calls from other libraries and the OS are not seen.
+namespace AllocCounter
+{
+    // True when this build counts allocations.
+    bool Enabled();
+
+    // Allocations made by the calling thread so far.  Take the difference
+    // around a piece of work to count what it allocated.
+    uint64_t ThisThread();
+}
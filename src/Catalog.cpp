@@ -0,0 +1,350 @@
+#include "Catalog.h"
+
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <string>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+// ── Internal state ─────────────────────────────────────────────────────────────
+
+static std::mutex s_Mutex;
+
+// String arena: fixed-size chunks that are never reallocated or freed.
+// A string larger than a chunk gets a chunk of its own.
+static const size_t CHUNK_BYTES = 64 * 1024;
+
+static std::vector<std::unique_ptr<char[]>> s_Chunks;
+static size_t                               s_ChunkUsed   = CHUNK_BYTES; // forces first chunk
+static size_t                               s_ArenaBytes  = 0;
+static size_t                               s_StringBytes = 0;
+static std::unordered_set<std::string_view> s_Strings;
+
+// Entries live in deques so their addresses never change.
+static std::deque<Catalog::Item>     s_Items;
+static std::deque<Catalog::Currency> s_Currencies;
+
+// Every version of each ID, current one last.
+static std::unordered_map<int, std::vector<const Catalog::Item*>>     s_ItemVersions;
+static std::unordered_map<int, std::vector<const Catalog::Currency*>> s_CurrencyVersions;
+
+// Every item entry in the order it became current (for CurrentItemsSince).
+static std::vector<const Catalog::Item*> s_CurrentItemLog;
+
+// Rarity / type strings of entries whose enum decoded to Unknown.
+struct Spellings
+{
+    std::string_view rarity;
+    std::string_view type;
+};
+static std::unordered_map<const Catalog::Item*, Spellings> s_Spellings;
+
+static std::unordered_map<int, const Catalog::Item*>     s_ItemPlaceholders;
+static std::unordered_map<int, const Catalog::Currency*> s_CurrencyPlaceholders;
+
+// ── Interning (caller holds s_Mutex) ──────────────────────────────────────────
+
+static std::string_view InternLocked(std::string_view s)
+{
+    auto it = s_Strings.find(s);
+    if (it != s_Strings.end()) return *it;
+
+    const size_t need = s.size() + 1; // NUL-terminated for ImGui / Nexus calls
+    char* dst;
+    if (need > CHUNK_BYTES / 4)
+    {
+        s_Chunks.emplace_back(new char[need]);
+        s_ArenaBytes += need;
+        dst = s_Chunks.back().get();
+        // Keep filling the previous chunk: swap the big one behind it.
+        if (s_Chunks.size() > 1) std::swap(s_Chunks.back(), s_Chunks[s_Chunks.size() - 2]);
+    }
+    else
+    {
+        if (s_ChunkUsed + need > CHUNK_BYTES)
+        {
+            s_Chunks.emplace_back(new char[CHUNK_BYTES]);
+            s_ArenaBytes += CHUNK_BYTES;
+            s_ChunkUsed   = 0;
+        }
+        dst = s_Chunks.back().get() + s_ChunkUsed;
+        s_ChunkUsed += need;
+    }
+
+    memcpy(dst, s.data(), s.size());
+    dst[s.size()] = '\0';
+    s_StringBytes += need;
+
+    std::string_view out(dst, s.size());
+    s_Strings.insert(out);
+    return out;
+}
+
+// Interned views are equal exactly when their data pointers are.  b is the
+// incoming entry; an empty icon (restored from history) matches any.
+static bool SameIcon(std::string_view a, std::string_view b)
+{
+    return b.empty() || a.data() == b.data();
+}
+
+static bool SameEntry(const Catalog::Item& a, const Catalog::Item& b)
+{
+    return a.name.data()        == b.name.data()
+        && SameIcon(a.iconUrl, b.iconUrl)
+        && a.rarity             == b.rarity
+        && a.chatLink.data()    == b.chatLink.data()
+        && a.description.data() == b.description.data()
+        && a.type               == b.type
+        && a.vendorValue        == b.vendorValue;
+}
+
+static Spellings SpellingsOf(const Catalog::Item* e)
+{
+    auto it = s_Spellings.find(e);
+    return it != s_Spellings.end() ? it->second : Spellings{};
+}
+
+static bool SameEntry(const Catalog::Currency& a, const Catalog::Currency& b)
+{
+    return a.name.data() == b.name.data() && SameIcon(a.iconUrl, b.iconUrl);
+}
+
+// Spellings the enums can't hold go to sp; the rest are left empty.
+static Catalog::Item MakeItem(const GW2Api::ItemInfo& info, Spellings& sp)
+{
+    Catalog::Item e;
+    e.id          = info.id;
+    e.name        = InternLocked(info.name);
+    e.rarity      = ItemEnums::ParseRarity(info.rarity);
+    e.chatLink    = InternLocked(info.chatLink);
+    e.description = InternLocked(info.description);
+    e.type        = ItemEnums::ParseType(info.type);
+    sp = {};
+    if (e.rarity == ItemEnums::Rarity::Unknown && !info.rarity.empty())
+        sp.rarity = InternLocked(info.rarity);
+    if (e.type == ItemEnums::ItemType::Unknown && !info.type.empty())
+        sp.type = InternLocked(info.type);
+    e.textureId   = InternLocked("LT_ITEM_" + std::to_string(info.id));
+    e.iconUrl     = InternLocked(info.iconUrl);
+    e.vendorValue = info.vendorValue;
+    return e;
+}
+
+static Catalog::Currency MakeCurrency(const GW2Api::CurrencyInfo& info)
+{
+    Catalog::Currency e;
+    e.id        = info.id;
+    e.name      = InternLocked(info.name);
+    e.textureId = InternLocked("LT_CURRENCY_" + std::to_string(info.id));
+    e.iconUrl   = InternLocked(info.iconUrl);
+    return e;
+}
+
+// Finds a version of e that same() accepts, or appends e.  With makeCurrent
+// the result moves to the back of the version list.
+template <typename T, typename Same>
+static const T* Store(std::deque<T>& entries, std::vector<const T*>& versions,
+                      const T& e, bool makeCurrent, Same same)
+{
+    for (size_t i = 0; i < versions.size(); ++i)
+    {
+        if (!same(versions[i])) continue;
+        const T* found = versions[i];
+        if (makeCurrent && i + 1 != versions.size())
+        {
+            versions.erase(versions.begin() + i);
+            versions.push_back(found);
+        }
+        return found;
+    }
+
+    entries.push_back(e);
+    const T* added = &entries.back();
+    if (makeCurrent || versions.empty()) versions.push_back(added);
+    else                                 versions.insert(versions.end() - 1, added);
+    return added;
+}
+
+// Store() for items, logging the entry when the ID's current one changes.
+// Caller holds s_Mutex.
+static const Catalog::Item* StoreItem(const GW2Api::ItemInfo& info, bool makeCurrent)
+{
+    auto& versions = s_ItemVersions[info.id];
+    const Catalog::Item* before = versions.empty() ? nullptr : versions.back();
+    const size_t         entries = s_Items.size();
+
+    Spellings sp;
+    const Catalog::Item item = MakeItem(info, sp);
+    const Catalog::Item* e = Store(s_Items, versions, item, makeCurrent,
+        [&](const Catalog::Item* v)
+        {
+            Spellings vs = SpellingsOf(v);
+            return SameEntry(*v, item) && vs.rarity.data() == sp.rarity.data()
+                                       && vs.type.data()   == sp.type.data();
+        });
+    if (s_Items.size() != entries && (!sp.rarity.empty() || !sp.type.empty()))
+        s_Spellings.emplace(e, sp);
+    if (versions.back() != before) s_CurrentItemLog.push_back(versions.back());
+    return e;
+}
+
+// Store() for currencies.  Caller holds s_Mutex.
+static const Catalog::Currency* StoreCurrency(const GW2Api::CurrencyInfo& info, bool makeCurrent)
+{
+    const Catalog::Currency e = MakeCurrency(info);
+    return Store(s_Currencies, s_CurrencyVersions[info.id], e, makeCurrent,
+                 [&](const Catalog::Currency* v) { return SameEntry(*v, e); });
+}
+
+// ── Public API ─────────────────────────────────────────────────────────────────
+
+std::string_view Catalog::RarityName(const Item& item)
+{
+    if (item.rarity != ItemEnums::Rarity::Unknown) return ItemEnums::Name(item.rarity);
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    return SpellingsOf(&item).rarity;
+}
+
+std::string_view Catalog::TypeName(const Item& item)
+{
+    if (item.type != ItemEnums::ItemType::Unknown) return ItemEnums::Name(item.type);
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    return SpellingsOf(&item).type;
+}
+
+std::string_view Catalog::Intern(std::string_view s)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    return InternLocked(s);
+}
+
+const Catalog::Item* Catalog::UpdateItem(const GW2Api::ItemInfo& info)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    return StoreItem(info, true);
+}
+
+const Catalog::Currency* Catalog::UpdateCurrency(const GW2Api::CurrencyInfo& info)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    return StoreCurrency(info, true);
+}
+
+const Catalog::Item* Catalog::RestoreItem(const GW2Api::ItemInfo& info)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    return StoreItem(info, false);
+}
+
+const Catalog::Currency* Catalog::RestoreCurrency(const GW2Api::CurrencyInfo& info)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    return StoreCurrency(info, false);
+}
+
+const Catalog::Item* Catalog::ItemFor(int id)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    auto it = s_ItemVersions.find(id);
+    if (it != s_ItemVersions.end() && !it->second.empty()) return it->second.back();
+
+    const Item*& ph = s_ItemPlaceholders[id];
+    if (!ph)
+    {
+        GW2Api::ItemInfo info{};
+        info.id   = id;
+        info.name = "Item #" + std::to_string(id);
+        Spellings sp;
+        s_Items.push_back(MakeItem(info, sp));
+        ph = &s_Items.back();
+    }
+    return ph;
+}
+
+const Catalog::Currency* Catalog::CurrencyFor(int id)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    auto it = s_CurrencyVersions.find(id);
+    if (it != s_CurrencyVersions.end() && !it->second.empty()) return it->second.back();
+
+    const Currency*& ph = s_CurrencyPlaceholders[id];
+    if (!ph)
+    {
+        GW2Api::CurrencyInfo info{};
+        info.id   = id;
+        info.name = "Currency #" + std::to_string(id);
+        s_Currencies.push_back(MakeCurrency(info));
+        ph = &s_Currencies.back();
+    }
+    return ph;
+}
+
+const Catalog::Item* Catalog::FindItem(int id)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    auto it = s_ItemVersions.find(id);
+    return it != s_ItemVersions.end() && !it->second.empty() ? it->second.back() : nullptr;
+}
+
+const Catalog::Currency* Catalog::FindCurrency(int id)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    auto it = s_CurrencyVersions.find(id);
+    return it != s_CurrencyVersions.end() && !it->second.empty() ? it->second.back() : nullptr;
+}
+
+std::vector<const Catalog::Item*> Catalog::KnownItems()
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    std::vector<const Item*> result;
+    result.reserve(s_ItemVersions.size());
+    for (auto& [id, versions] : s_ItemVersions)
+        if (!versions.empty()) result.push_back(versions.back());
+    return result;
+}
+
+std::vector<const Catalog::Currency*> Catalog::KnownCurrencies()
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    std::vector<const Currency*> result;
+    result.reserve(s_CurrencyVersions.size());
+    for (auto& [id, versions] : s_CurrencyVersions)
+        if (!versions.empty()) result.push_back(versions.back());
+    return result;
+}
+
+size_t Catalog::CurrentItemsSince(size_t cursor, std::vector<const Item*>& out)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    if (cursor < s_CurrentItemLog.size())
+        out.insert(out.end(), s_CurrentItemLog.begin() + cursor, s_CurrentItemLog.end());
+    return s_CurrentItemLog.size();
+}
+
+Catalog::Stats Catalog::GetStats()
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    Stats st;
+    st.items       = s_Items.size();
+    st.currencies  = s_Currencies.size();
+    st.strings     = s_Strings.size();
+    st.stringBytes = s_StringBytes;
+    st.arenaBytes  = s_ArenaBytes;
+
+    // Hash containers: a node (value + next pointer) per element, a pointer
+    // per bucket.  Close enough to see which part of the catalog grows.
+    const size_t node = 2 * sizeof(void*);
+    st.entryBytes = s_Items.size() * sizeof(Item) + s_Currencies.size() * sizeof(Currency)
+                  + s_Strings.size() * (sizeof(std::string_view) + node)
+                  + s_Strings.bucket_count() * sizeof(void*)
+                  + s_CurrentItemLog.capacity() * sizeof(const Item*)
+                  + s_Spellings.size() * (sizeof(const Item*) + sizeof(Spellings) + node)
+                  + s_Spellings.bucket_count() * sizeof(void*);
+    for (auto& [id, versions] : s_ItemVersions)
+        st.entryBytes += sizeof(versions) + node + versions.capacity() * sizeof(const Item*);
+    for (auto& [id, versions] : s_CurrencyVersions)
+        st.entryBytes += sizeof(versions) + node + versions.capacity() * sizeof(const Currency*);
+    return st;
+}
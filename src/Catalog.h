@@ -0,0 +1,89 @@
+#pragma once
+#include "GW2Api.h"
+#include "ItemEnums.h"
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+// ── Item / currency catalog ───────────────────────────────────────────────────
+// Owns every display string (names, descriptions, icon URLs, texture IDs) once.
+// Strings are interned into an append-only arena; entries are immutable and
+// never freed, so the pointers and string_views handed out stay valid for the
+// life of the addon and may be read from any thread without locking.  Every
+// string_view's data() is NUL-terminated.
+//
+// When an item's info changes (new game build) a new entry becomes current;
+// deltas and saved sessions that point at the old entry keep showing what was
+// true when they were recorded.
+namespace Catalog
+{
+    struct Item
+    {
+        int                 id          = 0;
+        std::string_view    name;
+        std::string_view    chatLink;
+        std::string_view    description; // optional flavour/lore text
+        std::string_view    textureId;   // "LT_ITEM_{id}"
+        std::string_view    iconUrl;     // empty when only known from history
+        int                 vendorValue = 0; // copper coins
+        ItemEnums::Rarity   rarity      = ItemEnums::Rarity::Unknown; // spelled by RarityName()
+        ItemEnums::ItemType type        = ItemEnums::ItemType::Unknown;
+    };
+
+    struct Currency
+    {
+        int              id = 0;
+        std::string_view name;
+        std::string_view textureId;   // "LT_CURRENCY_{id}"
+        std::string_view iconUrl;     // empty when only known from history
+    };
+
+    // The API's spelling of an item's rarity / type: the enum's name, or for
+    // a spelling the enum tables don't know (Unknown), the string as it came.
+    // Only those few entries pay for keeping it, in a side table.
+    std::string_view RarityName(const Item& item);
+    std::string_view TypeName(const Item& item);
+
+    // Interns s; the result compares equal to s and is never freed.
+    std::string_view Intern(std::string_view s);
+
+    // Info resolved from the API or metadata.bin: becomes the current entry.
+    const Item*     UpdateItem(const GW2Api::ItemInfo& info);
+    const Currency* UpdateCurrency(const GW2Api::CurrencyInfo& info);
+
+    // Info restored from session history: reuses an identical entry if there
+    // is one, and only becomes current when the ID has no entry yet.  History
+    // doesn't keep icon URLs, so an empty one matches any.
+    const Item*     RestoreItem(const GW2Api::ItemInfo& info);
+    const Currency* RestoreCurrency(const GW2Api::CurrencyInfo& info);
+
+    // Current entry for id, or a shared "Item #id" / "Currency #id"
+    // placeholder when it isn't known yet.  Never null.
+    const Item*     ItemFor(int id);
+    const Currency* CurrencyFor(int id);
+
+    // Current entry for id, or null when it isn't known yet.
+    const Item*     FindItem(int id);
+    const Currency* FindCurrency(int id);
+
+    // Current entries for every known ID (placeholders excluded).
+    std::vector<const Item*>     KnownItems();
+    std::vector<const Currency*> KnownCurrencies();
+
+    // Appends to out every item entry that became current since cursor and
+    // returns the cursor to pass next time (start from 0).  Lets an index
+    // over the catalog follow it without rescanning KnownItems().
+    size_t CurrentItemsSince(size_t cursor, std::vector<const Item*>& out);
+
+    struct Stats
+    {
+        size_t items       = 0; // entries, including superseded versions
+        size_t currencies  = 0;
+        size_t strings     = 0; // distinct interned strings
+        size_t stringBytes = 0; // their bytes (with terminators)
+        size_t arenaBytes  = 0; // reserved for them
+        size_t entryBytes  = 0; // entries, version lists and the string set
+    };
+    Stats GetStats();
+}
@@ -1,10 +1,12 @@
 #include "GW2Api.h"
 #include "Settings.h"
-#include "Shared.h"
+#include "Mumble.h"
+#include "Log.h"
+#include "HttpTransport.h"
+#include "ItemStreamParser.h"
+#include "AllocCounter.h"
 
 #include <nlohmann/json.hpp>
-#include <windows.h>
-#include <winhttp.h>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -12,88 +14,224 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <future>
+#include <chrono>
 #include <algorithm>
+#include <memory>
+#include <deque>
 
 using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
 
-// ── WinHTTP helpers ──────────────────────────────────────────────────────────
+static double MsSince(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// ── Request scheduler ────────────────────────────────────────────────────────
+// The API throttles per key and per IP, and the poll thread, info resolution
+// and the currency prefetch all talk to it independently.  Every request
+// takes a token from one shared bucket first.  When tokens run short, waiters
+// are served strictly by priority class (snapshot > metadata > bulk), FIFO
+// within a class, so a metadata burst can't delay the next snapshot.
+
+// Sustained rate well under the API's documented limit, with room for a
+// full poll plus a few item batches in one burst.
+static const double BUCKET_CAPACITY      = 30.0;
+static const double REFILL_PER_SEC       = 5.0;
+// After a 429 the bucket is drained to this far below zero, pausing all
+// classes.  Several requests that were in flight together and all came back
+// 429 back off once, not once each.
+static const double THROTTLE_BACKOFF_SEC = 10.0;
+
+static const int PRIORITY_CLASSES = 3;
 
-static const wchar_t* GW2_HOST    = L"api.guildwars2.com";
-static const int      GW2_PORT    = INTERNET_DEFAULT_HTTPS_PORT;
+static std::mutex              s_SchedMutex;
+static std::condition_variable s_SchedCv;
+static double                  s_Tokens      = BUCKET_CAPACITY;
+static Clock::time_point       s_LastRefill  = Clock::now();
+static uint64_t                s_NextTicket  = 0;
+static std::vector<uint64_t>   s_Waiting[PRIORITY_CLASSES]; // tickets, per class, oldest first
+static uint64_t                s_Throttled   = 0;            // 429 responses
+static bool                    s_Cancelled   = false;        // unloading: fail instead of waiting
+static GW2Api::SchedulerStats::Class s_ClassStats[PRIORITY_CLASSES];
 
-// Performs a HTTPS GET to https://api.guildwars2.com/<path>
-// with an optional "Authorization: Bearer <apiKey>" header.
-// Returns the response body as UTF-8 string, or empty string on failure.
-static std::string HttpGet(const std::wstring& path, const std::string& apiKey = "")
+// Caller holds s_SchedMutex.
+static void RefillTokens()
 {
-    std::string result;
+    auto now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - s_LastRefill).count();
+    s_Tokens     = std::min(BUCKET_CAPACITY, s_Tokens + elapsed * REFILL_PER_SEC);
+    s_LastRefill = now;
+}
+
+// Blocks until a request of the given class may go out.  Returns false
+// (without taking a token) once CancelRequests() has been called.
+static bool AcquireToken(GW2Api::RequestPriority priority)
+{
+    const int cls = (int)priority;
+    auto t0 = Clock::now();
 
-    HINTERNET hSession = WinHttpOpen(
-        L"LootTracker/1.0",
-        WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-        WINHTTP_NO_PROXY_NAME,
-        WINHTTP_NO_PROXY_BYPASS,
-        0);
-    if (!hSession) return result;
+    std::unique_lock<std::mutex> lock(s_SchedMutex);
+    const uint64_t ticket = s_NextTicket++;
+    s_Waiting[cls].push_back(ticket);
 
-    HINTERNET hConnect = WinHttpConnect(hSession, GW2_HOST, GW2_PORT, 0);
-    if (!hConnect) { WinHttpCloseHandle(hSession); return result; }
+    // A lower class at the front may be asleep until its next token; wake it
+    // so it sees this request ahead of it.
+    for (int c = cls + 1; c < PRIORITY_CLASSES; ++c)
+        if (!s_Waiting[c].empty()) { s_SchedCv.notify_all(); break; }
 
-    HINTERNET hReq = WinHttpOpenRequest(
-        hConnect,
-        L"GET",
-        path.c_str(),
-        nullptr,
-        WINHTTP_NO_REFERER,
-        WINHTTP_DEFAULT_ACCEPT_TYPES,
-        WINHTTP_FLAG_SECURE);
-    if (!hReq)
+    for (;;)
     {
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return result;
+        if (s_Cancelled)
+        {
+            auto& q = s_Waiting[cls];
+            q.erase(std::find(q.begin(), q.end(), ticket));
+            lock.unlock();
+            s_SchedCv.notify_all();
+            return false;
+        }
+
+        bool myTurn = s_Waiting[cls].front() == ticket;
+        for (int c = 0; c < cls && myTurn; ++c)
+            myTurn = s_Waiting[c].empty();
+
+        RefillTokens();
+        if (myTurn && s_Tokens >= 1.0) break;
+
+        if (myTurn)
+        {
+            // Sleep until the next token is due; a higher class arriving
+            // in the meantime wakes us through the condition variable.
+            double waitSec = (1.0 - s_Tokens) / REFILL_PER_SEC;
+            s_SchedCv.wait_for(lock, std::chrono::duration<double>(waitSec));
+        }
+        else
+            s_SchedCv.wait(lock);
     }
 
-    // Add auth header if key provided
-    if (!apiKey.empty())
+    // A handful of waiters at most: erasing the front is cheap, and unlike a
+    // deque the vector never allocates again once it has grown.
+    s_Tokens -= 1.0;
+    s_Waiting[cls].erase(s_Waiting[cls].begin());
+
+    double waitedMs = MsSince(t0);
+    GW2Api::SchedulerStats::Class& st = s_ClassStats[cls];
+    ++st.requests;
+    st.totalWaitMs += waitedMs;
+    st.maxWaitMs    = std::max(st.maxWaitMs, waitedMs);
+
+    lock.unlock();
+    s_SchedCv.notify_all(); // the next waiter may now be at the front
+    return true;
+}
+
+static void OnThrottled()
+{
     {
-        std::wstring authHeader = L"Authorization: Bearer " +
-            std::wstring(apiKey.begin(), apiKey.end());
-        WinHttpAddRequestHeaders(hReq, authHeader.c_str(), (DWORD)-1,
-                                 WINHTTP_ADDREQ_FLAG_ADD);
+        std::lock_guard<std::mutex> lock(s_SchedMutex);
+        RefillTokens();
+        s_Tokens = std::min(s_Tokens, -THROTTLE_BACKOFF_SEC * REFILL_PER_SEC);
+        ++s_Throttled;
     }
+    Log::Write(Log::Level::Warning, "GW2 API rate limit hit (429) — backing off all requests.");
+}
 
-    BOOL sent = WinHttpSendRequest(hReq,
-        WINHTTP_NO_ADDITIONAL_HEADERS, 0,
-        WINHTTP_NO_REQUEST_DATA, 0, 0, 0);
+// The only way requests reach the transport.
+static bool ScheduledGet(GW2Api::RequestPriority priority,
+                         const Http::Request&    req,
+                         Http::Response&         resp)
+{
+    if (!AcquireToken(priority)) return false;
+    std::shared_ptr<Http::ITransport> transport = Http::GetTransport();
+    if (!transport || !transport->Get(req, resp)) return false;
+    if (resp.status == 429) OnThrottled();
+    return true;
+}
 
-    if (sent && WinHttpReceiveResponse(hReq, nullptr))
+void GW2Api::CancelRequests()
+{
     {
-        DWORD statusCode = 0;
-        DWORD statusSize = sizeof(statusCode);
-        WinHttpQueryHeaders(hReq,
-            WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
-            WINHTTP_HEADER_NAME_BY_INDEX,
-            &statusCode, &statusSize,
-            WINHTTP_NO_HEADER_INDEX);
+        std::lock_guard<std::mutex> lock(s_SchedMutex);
+        s_Cancelled = true;
+    }
+    s_SchedCv.notify_all();
+}
 
-        if (statusCode == 200)
-        {
-            DWORD bytesAvail = 0;
-            while (WinHttpQueryDataAvailable(hReq, &bytesAvail) && bytesAvail > 0)
-            {
-                std::vector<char> buf(bytesAvail + 1, '\0');
-                DWORD bytesRead = 0;
-                WinHttpReadData(hReq, buf.data(), bytesAvail, &bytesRead);
-                result.append(buf.data(), bytesRead);
-            }
-        }
+GW2Api::SchedulerStats GW2Api::GetSchedulerStats()
+{
+    std::lock_guard<std::mutex> lock(s_SchedMutex);
+    RefillTokens();
+    SchedulerStats st;
+    for (int c = 0; c < PRIORITY_CLASSES; ++c)
+    {
+        st.classes[c]        = s_ClassStats[c];
+        st.classes[c].queued = (uint32_t)s_Waiting[c].size();
     }
+    st.tokens    = s_Tokens;
+    st.throttled = s_Throttled;
+    return st;
+}
 
-    WinHttpCloseHandle(hReq);
-    WinHttpCloseHandle(hConnect);
-    WinHttpCloseHandle(hSession);
-    return result;
+// ── HTTP helpers ─────────────────────────────────────────────────────────────
+
+// Lookups run on whichever thread asks, and FetchInBatches' helper threads
+// last one call, so a thread_local arena would be rebuilt (inflate state
+// included) every time.  Lookups borrow an arena from this pool instead and
+// hand it back once the body has been parsed.
+static std::mutex                                        s_ArenaPoolMutex;
+static std::vector<std::unique_ptr<Http::ResponseArena>> s_ArenaPool;
+
+class PooledArena
+{
+public:
+    PooledArena()
+    {
+        std::lock_guard<std::mutex> lock(s_ArenaPoolMutex);
+        if (s_ArenaPool.empty()) { m_Arena = std::make_unique<Http::ResponseArena>(); return; }
+        m_Arena = std::move(s_ArenaPool.back());
+        s_ArenaPool.pop_back();
+    }
+    ~PooledArena()
+    {
+        std::lock_guard<std::mutex> lock(s_ArenaPoolMutex);
+        s_ArenaPool.push_back(std::move(m_Arena));
+    }
+    PooledArena(const PooledArena&)            = delete;
+    PooledArena& operator=(const PooledArena&) = delete;
+
+    Http::ResponseArena& Get() { return *m_Arena; }
+
+private:
+    std::unique_ptr<Http::ResponseArena> m_Arena;
+};
+
+// Performs a GET to https://api.guildwars2.com/<path> through the shared
+// transport, with an optional "Authorization: Bearer <apiKey>" header.
+// Returns the HTTP status (0 if no response arrived) and sets body to the
+// UTF-8 response body.  The body lives in arena and is only valid until its
+// next request — parse it before issuing another one.
+static int HttpGetStatus(Http::ResponseArena& arena, GW2Api::RequestPriority priority,
+                         const std::wstring& path, const std::string& apiKey,
+                         std::string_view& body)
+{
+    body = {};
+    Http::Request req;
+    req.path   = path;
+    req.apiKey = apiKey;
+    req.arena  = &arena;
+    Http::Response resp;
+    if (!ScheduledGet(priority, req, resp)) return 0;
+    body = arena.View();
+    return resp.status;
+}
+
+// HttpGetStatus for callers that only want a 200 body; empty on failure.
+static std::string_view HttpGet(Http::ResponseArena& arena, GW2Api::RequestPriority priority,
+                                const std::wstring& path, const std::string& apiKey = "")
+{
+    std::string_view body;
+    return HttpGetStatus(arena, priority, path, apiKey, body) == 200 ? body : std::string_view{};
 }
 
 // Build a query URL like /v2/items?ids=1,2,3&lang=en
@@ -117,7 +255,8 @@ GW2Api::KeyStatus GW2Api::ValidateKey(const std::string& apiKey)
 {
     if (apiKey.empty()) return KeyStatus::Invalid;
 
-    std::string body = HttpGet(L"/v2/tokeninfo", apiKey);
+    PooledArena      arena;
+    std::string_view body = HttpGet(arena.Get(), RequestPriority::Metadata, L"/v2/tokeninfo", apiKey);
     if (body.empty()) return KeyStatus::Invalid;
 
     try
@@ -139,253 +278,724 @@ GW2Api::KeyStatus GW2Api::ValidateKey(const std::string& apiKey)
     catch (...) { return KeyStatus::Invalid; }
 }
 
-bool GW2Api::FetchSnapshot(const std::string& apiKey,
-                            const std::string& characterName,
-                            Snapshot&          out)
+// URL-encode a character name for use in a path (spaces -> %20, etc.).
+// Written into path in place, so its buffer is reused from poll to poll.
+static void CharacterInventoryPath(const std::string& characterName, std::wstring& path)
 {
-    // ── Wallet ────────────────────────────────────────────────────────────────
+    static const char HEX[] = "0123456789ABCDEF";
+    path.assign(L"/v2/characters/");
+    for (char c : characterName)
     {
-        std::string body = HttpGet(L"/v2/account/wallet", apiKey);
-        if (body.empty()) return false;
-        try
+        if (isalnum((unsigned char)c) || c == '-' || c == '_' || c == '.' || c == '~')
+            path += (wchar_t)c;
+        else
         {
-            json j = json::parse(body);
-            out.wallet.clear();
-            for (auto& entry : j)
-                out.wallet.push_back({ entry["id"].get<int>(),
-                                       entry["value"].get<int64_t>() });
+            unsigned char b = (unsigned char)c;
+            path += L'%';
+            path += (wchar_t)HEX[b >> 4];
+            path += (wchar_t)HEX[b & 15];
         }
-        catch (...) { return false; }
     }
+    path.append(L"/inventory");
+}
 
-    // ── Character inventory ───────────────────────────────────────────────────
-    out.inventory.clear();
-    if (!characterName.empty())
+// ── Conditional-request cache ────────────────────────────────────────────────
+// Most polls return the same bank and materials body as the last one.  Each
+// snapshot endpoint remembers its validators and the section it parsed, so a
+// 304 skips the download and the parse.  A byte-identical 200 keeps the
+// cached section too, but only the wallet's buffered body skips its parse:
+// inventory bodies are parsed as they stream in, before the hash is known.
+
+struct CachedSection
+{
+    std::string                      etag;
+    std::string                      lastModified;
+    uint64_t                         bodyHash = 0;
+    size_t                           bodySize = 0;
+    std::vector<GW2Api::WalletEntry> wallet; // /v2/account/wallet
+    std::vector<GW2Api::ItemStack>   items;  // every inventory endpoint
+};
+
+static std::mutex                                      s_CacheMutex;
+static std::string                                     s_CacheApiKey; // cache belongs to one key
+static std::unordered_map<std::wstring, CachedSection> s_Cache;       // path -> last result
+
+static std::atomic<uint64_t> s_NotModified     { 0 };
+static std::atomic<uint64_t> s_IdenticalBodies { 0 };
+static std::atomic<uint64_t> s_FullParses      { 0 };
+
+// Result of one snapshot endpoint request.
+struct Fetched
+{
+    enum Result { Failed, Unchanged, Changed };
+
+    Result           result   = Failed;
+    std::string_view body;             // Changed, buffered endpoints (wallet) — points into the arena
+    bool             parsed   = false; // streamed body was well-formed
+    uint64_t         bodyHash = 0;
+    size_t           bodySize = 0;
+};
+
+// Inventory endpoints are parsed while they download instead of buffered.
+struct ItemSource
+{
+    ItemStreamParser::Layout layout;
+    int                      slotMarker;
+};
+
+// 64-bit FNV-1a, fed incrementally — only used to recognise a repeated body.
+static const uint64_t FNV_OFFSET = 1469598103934665603ull;
+
+static uint64_t HashBytes(uint64_t h, const char* data, size_t len)
+{
+    for (size_t i = 0; i < len; ++i) { h ^= (unsigned char)data[i]; h *= 1099511628211ull; }
+    return h;
+}
+
+// ── Snapshot endpoints ───────────────────────────────────────────────────────
+// One long-lived worker per snapshot endpoint.  Each owns everything its
+// request needs from poll to poll — the request and response, the arena, the
+// stream parser and the stacks it parses into — so a steady-state poll reuses
+// all of it instead of building it again on a fresh thread.  Only the thread
+// calling FetchSnapshot hands out work, one job per endpoint at a time.
+struct Endpoint
+{
+    const ItemSource*                 source = nullptr; // null: body is buffered (wallet)
+    Http::Request                     req;
+    Http::Response                    resp;
+    Http::ResponseArena               arena;
+    std::unique_ptr<ItemStreamParser> parser;
+    std::vector<GW2Api::ItemStack>    items;  // streamed endpoints: what the parser produced
+    std::vector<GW2Api::WalletEntry>  wallet; // wallet: parsed from the body
+    Fetched                           result;
+    uint64_t                          hash        = 0;
+    size_t                            size        = 0;
+    double                            ms          = 0.0;
+    uint64_t                          allocations = 0; // by the worker, last job
+
+    std::thread             thread;
+    std::mutex              mutex;
+    std::condition_variable cv;
+    bool                    queued = false;
+    bool                    done   = true;
+    bool                    exit   = false;
+};
+
+// GET with If-None-Match / If-Modified-Since taken from the cache.  Reports
+// Unchanged for a 304 or for a 200 whose body matches the cached one.  With an
+// ItemSource the body is fed to the endpoint's parser as it arrives;
+// otherwise it is buffered in the endpoint's arena.
+static void ConditionalGet(Endpoint& ep)
+{
+    Fetched& f = ep.result;
+    f = Fetched{};
+
+    Http::Request& req = ep.req;
+    bool   haveCached = false;
+    size_t sizeHint   = 0;
     {
-        // URL-encode the character name (spaces -> %20, etc.)
-        std::string encoded;
-        for (char c : characterName)
+        std::lock_guard<std::mutex> lock(s_CacheMutex);
+        if (req.apiKey != s_CacheApiKey)
         {
-            if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~')
-                encoded += c;
-            else
-            {
-                char buf[4];
-                sprintf_s(buf, "%%%02X", static_cast<unsigned char>(c));
-                encoded += buf;
-            }
+            s_Cache.clear();
+            s_CacheApiKey = req.apiKey;
+        }
+        auto it = s_Cache.find(req.path);
+        if (it != s_Cache.end())
+        {
+            haveCached          = true;
+            req.ifNoneMatch     = it->second.etag;
+            req.ifModifiedSince = it->second.lastModified;
+            sizeHint            = it->second.items.size();
         }
+        else
+        {
+            req.ifNoneMatch.clear();
+            req.ifModifiedSince.clear();
+        }
+    }
 
-        std::wstring path = L"/v2/characters/" +
-            std::wstring(encoded.begin(), encoded.end()) + L"/inventory";
+    ep.hash = FNV_OFFSET;
+    ep.size = 0;
+    if (ep.source)
+    {
+        // Stack counts barely move between polls; presize from the last one.
+        ep.items.clear();
+        ep.items.reserve(sizeHint + sizeHint / 8 + 16);
+        ep.parser->Reset();
+    }
 
-        std::string body = HttpGet(path, apiKey);
-        if (!body.empty())
+    Http::Response& resp = ep.resp;
+    if (!ScheduledGet(GW2Api::RequestPriority::Snapshot, req, resp)) return;
+
+    // 304 is a success, not a failure: the cached section is still current.
+    if (resp.status == 304)
+    {
+        if (haveCached)
         {
-            try
-            {
-                json j = json::parse(body);
-                int slot = 0;
-                for (auto& bag : j["bags"])
-                {
-                    if (bag.is_null()) { ++slot; continue; }
-                    for (auto& item : bag["inventory"])
-                    {
-                        if (!item.is_null())
-                            out.inventory.push_back({
-                                item["id"].get<int>(),
-                                item["count"].get<int>(),
-                                slot });
-                        ++slot;
-                    }
-                }
-            }
-            catch (...) { /* partial failure ok — wallet already fetched */ }
+            ++s_NotModified;
+            f.result = Fetched::Unchanged;
         }
+        return;
+    }
+    if (resp.status != 200) return;
+
+    if (!ep.source)
+    {
+        std::string_view body = ep.arena.View();
+        ep.hash = HashBytes(ep.hash, body.data(), body.size());
+        ep.size = body.size();
     }
+    if (ep.size == 0) return;
+    f.bodyHash = ep.hash;
+    f.bodySize = ep.size;
 
-    // ── Material storage ─────────────────────────────────────────────────────
-    // Merging material storage counts into inventory means that auto-deposit
-    // (items moving from bags to material storage) doesn't show as a negative
-    // delta — only true account-wide gains/losses are reflected.
     {
-        std::string body = HttpGet(L"/v2/account/materials", apiKey);
-        if (!body.empty())
+        std::lock_guard<std::mutex> lock(s_CacheMutex);
+        auto it = s_Cache.find(req.path);
+        if (it != s_Cache.end() &&
+            it->second.bodyHash == f.bodyHash &&
+            it->second.bodySize == f.bodySize)
         {
-            try
-            {
-                // Build a quick lookup index into out.inventory
-                std::unordered_map<int, size_t> idx;
-                idx.reserve(out.inventory.size());
-                for (size_t i = 0; i < out.inventory.size(); ++i)
-                    idx[out.inventory[i].id] = i;
-
-                json j = json::parse(body);
-                for (auto& entry : j)
-                {
-                    int id    = entry["id"].get<int>();
-                    int count = entry["count"].get<int>();
-                    if (count <= 0) continue;
-
-                    auto it = idx.find(id);
-                    if (it != idx.end())
-                        out.inventory[it->second].count += count;
-                    else
-                    {
-                        idx[id] = out.inventory.size();
-                        out.inventory.push_back({ id, count, -1 }); // slot -1 = material storage
-                    }
-                }
-            }
-            catch (...) { /* partial failure ok */ }
+            // Same bytes as last time — keep the cached section, refresh validators.
+            it->second.etag         = resp.etag;
+            it->second.lastModified = resp.lastModified;
+            if (ep.source) ++s_FullParses; // streamed: parsed already
+            else           ++s_IdenticalBodies;
+            f.result = Fetched::Unchanged;
+            return;
         }
     }
 
-    // ── Account bank ─────────────────────────────────────────────────────────
-    // Merging bank prevents items moved from bags to bank showing as losses.
+    f.result = Fetched::Changed;
+    f.parsed = ep.source && ep.parser->Finish();
+    f.body   = ep.source ? std::string_view() : ep.arena.View();
+}
+
+static void EndpointLoop(Endpoint* ep)
+{
+    std::unique_lock<std::mutex> lock(ep->mutex);
+    for (;;)
     {
-        std::string body = HttpGet(L"/v2/account/bank", apiKey);
-        if (!body.empty())
+        ep->cv.wait(lock, [ep] { return ep->queued || ep->exit; });
+        if (ep->exit) break;
+        ep->queued = false;
+        lock.unlock();
+
+        const uint64_t allocs0 = AllocCounter::ThisThread();
+        const auto     t0      = Clock::now();
+        ConditionalGet(*ep);
+        ep->ms          = MsSince(t0);
+        ep->allocations = AllocCounter::ThisThread() - allocs0;
+
+        lock.lock();
+        ep->done = true;
+        ep->cv.notify_all();
+    }
+}
+
+// Sets up the endpoint's parser and output, and starts its worker.  Does
+// nothing if it is already running.
+static void StartEndpoint(Endpoint& ep, const ItemSource* source, const wchar_t* path)
+{
+    if (ep.thread.joinable()) return;
+    ep.source = source;
+    if (path) ep.req.path = path;
+    ep.req.arena = &ep.arena;
+    if (source && !ep.parser)
+    {
+        ep.parser = std::make_unique<ItemStreamParser>(source->layout, source->slotMarker, ep.items);
+        // Set once: the sink outlives every request.
+        ep.req.onData = [&ep](const char* data, size_t len)
         {
-            try
-            {
-                std::unordered_map<int, size_t> idx;
-                for (size_t i = 0; i < out.inventory.size(); ++i)
-                    idx[out.inventory[i].id] = i;
+            ep.hash  = HashBytes(ep.hash, data, len);
+            ep.size += len;
+            ep.parser->Feed(data, len);
+        };
+    }
+    ep.exit   = false;
+    ep.done   = true;
+    ep.thread = std::thread(EndpointLoop, &ep);
+}
 
-                json j = json::parse(body);
-                for (auto& slot : j)
-                {
-                    if (slot.is_null()) continue;
-                    int id    = slot["id"].get<int>();
-                    int count = slot.value("count", 0);
-                    if (count <= 0) continue;
-                    auto it = idx.find(id);
-                    if (it != idx.end())
-                        out.inventory[it->second].count += count;
-                    else
-                    {
-                        idx[id] = out.inventory.size();
-                        out.inventory.push_back({ id, count, -2 }); // slot -2 = bank
-                    }
-                }
-            }
-            catch (...) { /* partial failure ok */ }
+static void StopEndpoint(Endpoint& ep)
+{
+    if (!ep.thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(ep.mutex);
+        ep.exit = true;
+    }
+    ep.cv.notify_all();
+    ep.thread.join();
+}
+
+// Hands the endpoint its next request; its path is already set.
+static void Dispatch(Endpoint& ep, const std::string& apiKey)
+{
+    ep.req.apiKey = apiKey;
+    {
+        std::lock_guard<std::mutex> lock(ep.mutex);
+        ep.queued = true;
+        ep.done   = false;
+    }
+    ep.cv.notify_all();
+}
+
+static void WaitFor(Endpoint& ep)
+{
+    std::unique_lock<std::mutex> lock(ep.mutex);
+    ep.cv.wait(lock, [&ep] { return ep.done; });
+}
+
+// Records a freshly parsed section together with the validators it came
+// with.  The section is swapped into the cache, so section gets back the
+// previous one's buffer to parse into next time.
+template <typename T>
+static void StoreSection(Endpoint& ep, std::vector<T> CachedSection::* member,
+                         std::vector<T>& section)
+{
+    ++s_FullParses;
+    std::lock_guard<std::mutex> lock(s_CacheMutex);
+    CachedSection& c = s_Cache[ep.req.path];
+    c.etag.swap(ep.resp.etag);
+    c.lastModified.swap(ep.resp.lastModified);
+    c.bodyHash = ep.result.bodyHash;
+    c.bodySize = ep.result.bodySize;
+    (c.*member).swap(section);
+}
+
+// Wallet section: parsed from the body when Changed, then read back from the
+// cache either way.
+static bool ResolveWallet(Endpoint& ep, std::vector<GW2Api::WalletEntry>& wallet)
+{
+    wallet.clear();
+    const Fetched& f = ep.result;
+    if (f.result == Fetched::Failed) return false;
+    if (f.result == Fetched::Changed)
+    {
+        ep.wallet.clear();
+        try
+        {
+            json j = json::parse(f.body);
+            for (auto& entry : j)
+                ep.wallet.push_back({ entry["id"].get<int>(),
+                                      entry["value"].get<int64_t>() });
         }
+        catch (...) { return false; }
+        StoreSection(ep, &CachedSection::wallet, ep.wallet);
     }
 
-    // ── Shared inventory slots (gem-store bags) ───────────────────────────────
+    std::lock_guard<std::mutex> lock(s_CacheMutex);
+    auto it = s_Cache.find(ep.req.path);
+    if (it == s_Cache.end()) return false;
+    wallet.assign(it->second.wallet.begin(), it->second.wallet.end());
+    return true;
+}
+
+// ── Stack index ───────────────────────────────────────────────────────────────
+// Item ID -> position in Snapshot::inventory, shared by every item source of a
+// poll.  Open addressing with linear probing over a power-of-two table that
+// lives as long as the addon: Reset() bumps a generation instead of clearing,
+// and the table only grows, so a steady-state poll neither rehashes nor
+// allocates.  Only the polling thread touches it.
+class StackIndex
+{
+public:
+    void Reset()
     {
-        std::string body = HttpGet(L"/v2/account/inventory", apiKey);
-        if (!body.empty())
+        if (++m_Gen == 0) // wrapped: stale stamps could look current
         {
-            try
-            {
-                std::unordered_map<int, size_t> idx;
-                for (size_t i = 0; i < out.inventory.size(); ++i)
-                    idx[out.inventory[i].id] = i;
+            for (auto& s : m_Slots) s.gen = 0;
+            m_Gen = 1;
+        }
+        m_Size = 0;
+    }
 
-                json j = json::parse(body);
-                for (auto& slot : j)
-                {
-                    if (slot.is_null()) continue;
-                    int id    = slot["id"].get<int>();
-                    int count = slot.value("count", 0);
-                    if (count <= 0) continue;
-                    auto it = idx.find(id);
-                    if (it != idx.end())
-                        out.inventory[it->second].count += count;
-                    else
-                    {
-                        idx[id] = out.inventory.size();
-                        out.inventory.push_back({ id, count, -3 }); // slot -3 = shared
-                    }
-                }
-            }
-            catch (...) { /* partial failure ok */ }
+    // Position stored for id, or the not-yet-used `next` after recording it.
+    size_t FindOrInsert(int id, size_t next)
+    {
+        if ((m_Size + 1) * 2 > m_Slots.size()) Grow();
+        Slot* s = Probe(id);
+        if (s->gen != m_Gen)
+        {
+            *s = { id, m_Gen, next };
+            ++m_Size;
         }
+        return s->pos;
     }
 
+    size_t Size() const { return m_Size; }
+
+private:
+    struct Slot
+    {
+        int      id  = 0;
+        uint32_t gen = 0; // slot is live when gen == m_Gen
+        size_t   pos = 0;
+    };
+
+    Slot* Probe(int id)
+    {
+        const size_t mask = m_Slots.size() - 1;
+        size_t i = ((uint32_t)id * 2654435769u) & mask; // Fibonacci hashing
+        while (m_Slots[i].gen == m_Gen && m_Slots[i].id != id)
+            i = (i + 1) & mask;
+        return &m_Slots[i];
+    }
+
+    void Grow()
+    {
+        std::vector<Slot> old;
+        old.swap(m_Slots);
+        m_Slots.resize(old.empty() ? 1024 : old.size() * 2);
+        uint32_t gen = m_Gen;
+        m_Gen = 1;
+        for (auto& s : m_Slots) s.gen = 0;
+        for (auto& s : old)
+            if (s.gen == gen) *Probe(s.id) = { s.id, m_Gen, s.pos };
+    }
+
+    std::vector<Slot> m_Slots;
+    uint32_t          m_Gen  = 1;
+    size_t            m_Size = 0;
+};
+
+static StackIndex s_StackIndex;
+
+// Adds a section's counts onto existing stacks of the same item, appending
+// the first occurrence of each new ID (which keeps its slot marker).
+static void MergeSection(std::vector<GW2Api::ItemStack>&       inventory,
+                         const std::vector<GW2Api::ItemStack>& section)
+{
+    for (auto& st : section)
+    {
+        size_t pos = s_StackIndex.FindOrInsert(st.id, inventory.size());
+        if (pos == inventory.size()) inventory.push_back(st);
+        else                         inventory[pos].count += st.count;
+    }
+}
+
+// Item section: what the stream parser produced when Changed, the cached
+// section otherwise.  Merged into inventory straight from the cache, without
+// copying it out.  Returns false on request failure or a malformed body.
+static bool ResolveItems(Endpoint& ep, std::vector<GW2Api::ItemStack>& inventory)
+{
+    const Fetched& f = ep.result;
+    if (f.result == Fetched::Failed) return false;
+    if (f.result == Fetched::Changed)
+    {
+        if (!f.parsed) return false;
+        StoreSection(ep, &CachedSection::items, ep.items);
+    }
+
+    std::lock_guard<std::mutex> lock(s_CacheMutex);
+    auto it = s_Cache.find(ep.req.path);
+    if (it == s_Cache.end()) return false;
+    MergeSection(inventory, it->second.items);
     return true;
 }
 
-std::vector<GW2Api::ItemInfo> GW2Api::FetchItemDetails(const std::vector<int>& ids)
+static const ItemSource CHARACTER_SOURCE { ItemStreamParser::Layout::CharacterBags,  0 };
+static const ItemSource MATERIALS_SOURCE { ItemStreamParser::Layout::AccountSlots, -1 }; // slot -1 = material storage
+static const ItemSource BANK_SOURCE      { ItemStreamParser::Layout::AccountSlots, -2 }; // slot -2 = bank
+static const ItemSource SHARED_SOURCE    { ItemStreamParser::Layout::AccountSlots, -3 }; // slot -3 = shared
+
+static Endpoint s_WalletEndpoint;
+static Endpoint s_CharacterEndpoint;
+static Endpoint s_MaterialsEndpoint;
+static Endpoint s_BankEndpoint;
+static Endpoint s_SharedEndpoint;
+
+static std::mutex         s_TimingMutex;
+static GW2Api::PollTiming s_LastTiming;
+
+bool GW2Api::FetchSnapshot(const std::string& apiKey,
+                            const std::string& characterName,
+                            Snapshot&          out)
 {
-    std::vector<ItemInfo> result;
-    if (ids.empty()) return result;
+    // ── Fan out all five requests at once ─────────────────────────────────────
+    // Poll latency is the slowest round trip rather than the sum of all five.
+    // Each section below waits for its own response and merges in the
+    // original order, so partial-failure handling and slot markers are
+    // unchanged.
+    PollTiming timing;
+    auto t0 = Clock::now();
+    uint64_t allocs0 = AllocCounter::ThisThread();
+    double   wait0   = GetSchedulerStats().classes[(int)RequestPriority::Snapshot].totalWaitMs;
+
+    StartEndpoint(s_WalletEndpoint,    nullptr,           L"/v2/account/wallet");
+    StartEndpoint(s_CharacterEndpoint, &CHARACTER_SOURCE, nullptr);
+    StartEndpoint(s_MaterialsEndpoint, &MATERIALS_SOURCE, L"/v2/account/materials");
+    StartEndpoint(s_BankEndpoint,      &BANK_SOURCE,      L"/v2/account/bank");
+    StartEndpoint(s_SharedEndpoint,    &SHARED_SOURCE,    L"/v2/account/inventory");
+
+    const bool withCharacter = !characterName.empty();
+    if (withCharacter) CharacterInventoryPath(characterName, s_CharacterEndpoint.req.path);
+    Endpoint* endpoints[] = { &s_WalletEndpoint, &s_CharacterEndpoint, &s_MaterialsEndpoint,
+                              &s_BankEndpoint, &s_SharedEndpoint };
+    for (Endpoint* ep : endpoints)
+        if (ep != &s_CharacterEndpoint || withCharacter) Dispatch(*ep, apiKey);
+
+    // Every endpoint is waited for, even after a failure: a worker still
+    // running would otherwise be handed its next job mid-request.
+    for (Endpoint* ep : endpoints)
+        if (ep != &s_CharacterEndpoint || withCharacter) WaitFor(*ep);
+
+    // ── Wallet ────────────────────────────────────────────────────────────────
+    if (!ResolveWallet(s_WalletEndpoint, out.wallet))
+        return false;
 
-    // The GW2 API accepts at most 200 IDs per request
-    for (size_t offset = 0; offset < ids.size(); offset += 200)
+    // ── Items: character, material storage, bank, shared slots ───────────────
+    // All four merge into one list with a single stack per item ID.  Merging
+    // material storage means auto-deposit (bags -> storage) doesn't show as a
+    // negative delta, and merging the bank does the same for items moved
+    // there — only true account-wide gains/losses are reflected.  A failed
+    // item section is skipped; the wallet is already fetched.
+    out.inventory.clear();
+    out.inventory.reserve(s_StackIndex.Size()); // last poll's stack count
+    s_StackIndex.Reset();
+    for (Endpoint* ep : endpoints)
+        if (ep->source && (ep != &s_CharacterEndpoint || withCharacter))
+            ResolveItems(*ep, out.inventory);
+
+    timing.walletMs    = s_WalletEndpoint.ms;
+    timing.characterMs = withCharacter ? s_CharacterEndpoint.ms : 0.0;
+    timing.materialsMs = s_MaterialsEndpoint.ms;
+    timing.bankMs      = s_BankEndpoint.ms;
+    timing.sharedMs    = s_SharedEndpoint.ms;
+    timing.totalMs     = MsSince(t0);
+    timing.serialMs    = timing.walletMs + timing.characterMs + timing.materialsMs
+                       + timing.bankMs + timing.sharedMs;
+    timing.allocations = AllocCounter::ThisThread() - allocs0;
+    for (Endpoint* ep : endpoints)
+        if (ep != &s_CharacterEndpoint || withCharacter) timing.allocations += ep->allocations;
     {
-        size_t end = std::min(offset + 200, ids.size());
-        std::vector<int> batch(ids.begin() + offset, ids.begin() + end);
+        std::lock_guard<std::mutex> lock(s_TimingMutex);
+        s_LastTiming = timing;
+    }
+    if (Log::Enabled())
+    {
+        Http::TransferStats xfer  = Http::GetTransferStats();
+        SchedulerStats      sched = GetSchedulerStats();
+        char allocs[48] = "allocations not counted";
+        if (AllocCounter::Enabled())
+            snprintf(allocs, sizeof(allocs), "%llu heap allocations",
+                     (unsigned long long)timing.allocations);
+        char buf[512];
+        snprintf(buf, sizeof(buf),
+            "Poll %.0f ms (sequential would be %.0f ms) — wallet %.0f, "
+            "character %.0f, materials %.0f, bank %.0f, shared %.0f | "
+            "cache: %llu not-modified, %llu identical, %llu parsed | "
+            "transfer: %llu KB wire / %llu KB decoded, %s | "
+            "scheduler: waited %.0f ms, %u metadata + %u bulk queued, %.1f tokens",
+            timing.totalMs, timing.serialMs,
+            timing.walletMs, timing.characterMs, timing.materialsMs,
+            timing.bankMs, timing.sharedMs,
+            (unsigned long long)s_NotModified.load(),
+            (unsigned long long)s_IdenticalBodies.load(),
+            (unsigned long long)s_FullParses.load(),
+            (unsigned long long)(xfer.wireBytes / 1024),
+            (unsigned long long)(xfer.decodedBytes / 1024),
+            allocs,
+            sched.classes[(int)RequestPriority::Snapshot].totalWaitMs - wait0,
+            sched.classes[(int)RequestPriority::Metadata].queued,
+            sched.classes[(int)RequestPriority::Bulk].queued,
+            sched.tokens);
+        Log::Write(Log::Level::Debug, buf);
+    }
 
-        std::string body = HttpGet(BuildIdsPath(L"/v2/items", batch));
-        if (body.empty()) continue;
+    return true;
+}
 
-        try
+GW2Api::CacheStats GW2Api::GetCacheStats()
+{
+    CacheStats st;
+    st.notModified     = s_NotModified.load();
+    st.identicalBodies = s_IdenticalBodies.load();
+    st.fullParses      = s_FullParses.load();
+    return st;
+}
+
+GW2Api::PollTiming GW2Api::GetLastPollTiming()
+{
+    std::lock_guard<std::mutex> lock(s_TimingMutex);
+    return s_LastTiming;
+}
+
+// ── Batched metadata lookups ──────────────────────────────────────────────────
+
+// The GW2 API accepts at most 200 IDs per request.
+static const size_t IDS_PER_BATCH        = 200;
+// Batches in flight at once; the scheduler still paces the actual requests.
+static const size_t MAX_PARALLEL_BATCHES = 4;
+
+// Splits ids into batches and runs fetchBatch on up to MAX_PARALLEL_BATCHES
+// threads.  Each batch's results go to onBatch as soon as that batch is in
+// (one call at a time), and everything is returned once all are done.  The
+// IDs of batches fetchBatch reports as failed are appended to *failed.
+template <typename T>
+static std::vector<T> FetchInBatches(
+    const std::vector<int>&                                         ids,
+    const std::function<bool(const std::vector<int>&, Http::ResponseArena&,
+                             std::vector<T>&)>&                     fetchBatch,
+    const std::function<void(const std::vector<T>&)>&               onBatch,
+    std::vector<int>*                                               failed)
+{
+    std::vector<T> result;
+    if (ids.empty()) return result;
+
+    const size_t batches = (ids.size() + IDS_PER_BATCH - 1) / IDS_PER_BATCH;
+    std::atomic<size_t> next { 0 };
+    std::mutex          resultMutex;
+
+    auto worker = [&]()
+    {
+        PooledArena arena;
+        for (size_t b = next++; b < batches; b = next++)
         {
-            json j = json::parse(body);
-            for (auto& item : j)
+            size_t offset = b * IDS_PER_BATCH;
+            size_t end    = std::min(offset + IDS_PER_BATCH, ids.size());
+            std::vector<int> batch(ids.begin() + offset, ids.begin() + end);
+            std::vector<T>   got;
+            if (!fetchBatch(batch, arena.Get(), got))
             {
-                ItemInfo info;
-                info.id          = item.value("id",           0);
-                info.name        = item.value("name",         "");
-                info.rarity      = item.value("rarity",       "");
-                info.iconUrl     = item.value("icon",         "");
-                info.chatLink    = item.value("chat_link",    "");
-                info.description = item.value("description",  "");
-                info.type        = item.value("type",         "");
-                info.vendorValue = item.value("vendor_value",  0);
-                result.push_back(std::move(info));
+                std::lock_guard<std::mutex> lock(resultMutex);
+                if (failed) failed->insert(failed->end(), batch.begin(), batch.end());
+                continue;
             }
+            if (got.empty()) continue;
+
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (onBatch) onBatch(got);
+            result.insert(result.end(),
+                          std::make_move_iterator(got.begin()),
+                          std::make_move_iterator(got.end()));
         }
-        catch (...) {}
-    }
+    };
+
+    // The calling thread works too, so a single batch spawns nothing.
+    std::vector<std::future<void>> helpers;
+    for (size_t i = 1; i < std::min(batches, MAX_PARALLEL_BATCHES); ++i)
+        helpers.push_back(std::async(std::launch::async, worker));
+    worker();
+    for (auto& h : helpers) h.get();
 
     return result;
 }
 
-std::vector<GW2Api::CurrencyInfo> GW2Api::FetchCurrencyDetails(const std::vector<int>& ids)
+// ?ids= lookups answer 206 when some of the IDs don't exist and 404 when
+// none do; both are complete answers.  Anything else means the batch failed.
+static bool FetchIds(Http::ResponseArena& arena, GW2Api::RequestPriority priority,
+                     const std::wstring& path, std::string_view& body)
 {
-    std::vector<CurrencyInfo> result;
-    if (ids.empty()) return result;
+    int status = HttpGetStatus(arena, priority, path, "", body);
+    if (status == 404) body = {};
+    return status == 200 || status == 206 || status == 404;
+}
+
+static bool FetchItemBatch(const std::vector<int>& batch, GW2Api::RequestPriority priority,
+                           Http::ResponseArena& arena, std::vector<GW2Api::ItemInfo>& result)
+{
+    std::string_view body;
+    if (!FetchIds(arena, priority, BuildIdsPath(L"/v2/items", batch), body)) return false;
+    if (body.empty()) return true;
+
+    try
+    {
+        json j = json::parse(body);
+        result.reserve(j.size());
+        for (auto& item : j)
+        {
+            GW2Api::ItemInfo info;
+            info.id          = item.value("id",           0);
+            info.name        = item.value("name",         "");
+            info.rarity      = item.value("rarity",       "");
+            info.iconUrl     = item.value("icon",         "");
+            info.chatLink    = item.value("chat_link",    "");
+            info.description = item.value("description",  "");
+            info.type        = item.value("type",         "");
+            info.vendorValue = item.value("vendor_value",  0);
+            result.push_back(std::move(info));
+        }
+    }
+    catch (...) { result.clear(); return false; }
 
-    std::string body = HttpGet(BuildIdsPath(L"/v2/currencies", ids));
-    if (body.empty()) return result;
+    return true;
+}
+
+static bool FetchCurrencyBatch(const std::vector<int>& batch, GW2Api::RequestPriority priority,
+                               Http::ResponseArena& arena,
+                               std::vector<GW2Api::CurrencyInfo>& result)
+{
+    std::string_view body;
+    if (!FetchIds(arena, priority, BuildIdsPath(L"/v2/currencies", batch), body)) return false;
+    if (body.empty()) return true;
 
     try
     {
         json j = json::parse(body);
+        result.reserve(j.size());
         for (auto& cur : j)
         {
-            CurrencyInfo info;
+            GW2Api::CurrencyInfo info;
             info.id      = cur.value("id",   0);
             info.name    = cur.value("name", "");
             info.iconUrl = cur.value("icon", "");
             result.push_back(std::move(info));
         }
     }
-    catch (...) {}
+    catch (...) { result.clear(); return false; }
 
-    return result;
+    return true;
 }
 
-std::vector<GW2Api::CurrencyInfo> GW2Api::FetchAllCurrencies()
+std::vector<GW2Api::ItemInfo> GW2Api::FetchItemDetails(const std::vector<int>& ids,
+                                                       RequestPriority         priority,
+                                                       const ItemBatchCallback& onBatch,
+                                                       std::vector<int>*       failedIds)
 {
-    // /v2/currencies with no IDs returns an array of all currency IDs
-    std::string body = HttpGet(L"/v2/currencies");
-    if (body.empty()) return {};
+    return FetchInBatches<ItemInfo>(ids,
+        [priority](const std::vector<int>& batch, Http::ResponseArena& arena,
+                   std::vector<ItemInfo>& out)
+        { return FetchItemBatch(batch, priority, arena, out); },
+        onBatch, failedIds);
+}
 
-    try
+std::vector<GW2Api::CurrencyInfo> GW2Api::FetchCurrencyDetails(const std::vector<int>& ids,
+                                                               RequestPriority         priority,
+                                                               const CurrencyBatchCallback& onBatch,
+                                                               std::vector<int>*       failedIds)
+{
+    return FetchInBatches<CurrencyInfo>(ids,
+        [priority](const std::vector<int>& batch, Http::ResponseArena& arena,
+                   std::vector<CurrencyInfo>& out)
+        { return FetchCurrencyBatch(batch, priority, arena, out); },
+        onBatch, failedIds);
+}
+
+std::vector<GW2Api::CurrencyInfo> GW2Api::FetchAllCurrencies(bool* complete)
+{
+    if (complete) *complete = false;
+
+    // /v2/currencies with no IDs returns an array of all currency IDs
+    std::vector<int> ids;
     {
-        json j = json::parse(body);
-        std::vector<int> ids;
-        ids.reserve(j.size());
-        for (auto& el : j) ids.push_back(el.get<int>());
-        return FetchCurrencyDetails(ids);
+        PooledArena      arena;
+        std::string_view body = HttpGet(arena.Get(), RequestPriority::Bulk, L"/v2/currencies");
+        if (body.empty()) return {};
+        try
+        {
+            json j = json::parse(body);
+            ids.reserve(j.size());
+            for (auto& el : j) ids.push_back(el.get<int>());
+        }
+        catch (...) { return {}; }
     }
-    catch (...) { return {}; }
+
+    std::vector<int> failed;
+    auto all = FetchCurrencyDetails(ids, RequestPriority::Bulk, {}, &failed);
+    if (complete) *complete = failed.empty();
+    return all;
 }
 
 // ── Background polling thread ─────────────────────────────────────────────────
@@ -397,22 +1007,131 @@ static std::condition_variable s_Cv;
 static bool                    s_PollNow   { false };
 static GW2Api::SnapshotCallback s_Callback;
 
+// ── Adaptive interval ─────────────────────────────────────────────────────────
+// The wait between polls shrinks toward PollIntervalMinSec while every poll
+// brings new loot, settles at PollIntervalSec while playing quietly, and
+// stretches toward PollIntervalMaxSec when nothing changes for a while or the
+// game is not running a map (character select, loading, minimised/closed).
+// Snapshot requests never exceed PollBudgetPerHour over any rolling hour.
+// The budget covers the poll's own requests only; item/currency lookups,
+// key checks and the currency prefetch go through the same token bucket
+// (which keeps the total under the API's limit) but not through the budget.
+
+static const int    QUIET_POLLS_BEFORE_IDLE = 3;   // unchanged polls before backing off
+static const double BACKOFF_FACTOR          = 1.5;
+static const int    ACTIVITY_CHECK_SEC      = 2;   // Mumble re-check while waiting
+static const auto   BUDGET_WINDOW           = std::chrono::hours(1);
+
+static std::atomic<int>         s_EffectiveIntervalSec { 30 };
+static std::atomic<const char*> s_IntervalReason       { "starting" };
+static std::atomic<int>         s_RequestsLastHour     { 0 };
+
+// MapId is 0 at character select and while no map is loaded.
+static bool InGame()
+{
+    return MumbleLink && MumbleLink->Context.MapId != 0;
+}
+
+// Fingerprint of what a session diff would see (counts, not bag positions).
+static uint64_t Fingerprint(const GW2Api::Snapshot& snap)
+{
+    uint64_t h = FNV_OFFSET;
+    auto mix = [&h](int64_t v) { h = HashBytes(h, (const char*)&v, sizeof(v)); };
+    for (auto& w : snap.wallet)    { mix(w.id); mix(w.value); }
+    for (auto& s : snap.inventory) { mix(s.id); mix(s.count); }
+    return h;
+}
+
+struct PollActivity
+{
+    bool inGame    = false;
+    bool tickAlive = false; // UITick moved since the previous poll
+    bool changed   = false; // snapshot differs from the previous one
+};
+
+// Picks the wait before the next poll from what the last one saw.
+static double NextInterval(double current, const PollActivity& act,
+                           int& quietPolls, int requestsPerPoll, const char*& reason)
+{
+    double minSec  = std::max(5, g_Settings.PollIntervalMinSec);
+    double maxSec  = std::max<double>(minSec, g_Settings.PollIntervalMaxSec);
+    double baseSec = std::clamp<double>(g_Settings.PollIntervalSec, minSec, maxSec);
+
+    double next;
+    if (!act.inGame || !act.tickAlive)
+    {
+        quietPolls = 0;
+        next   = std::max(current, baseSec) * 2.0;
+        reason = act.inGame ? "game inactive" : "out of game";
+    }
+    else if (act.changed)
+    {
+        quietPolls = 0;
+        next   = current / 2.0;
+        reason = "active";
+    }
+    else if (++quietPolls >= QUIET_POLLS_BEFORE_IDLE)
+    {
+        next   = std::max(current, baseSec) * BACKOFF_FACTOR;
+        reason = "idle";
+    }
+    else
+    {
+        // Drift back to the base interval: up after a burst, straight down
+        // after a back-off.
+        next   = current < baseSec ? std::min(baseSec, current * BACKOFF_FACTOR) : baseSec;
+        reason = "steady";
+    }
+    next = std::clamp(next, minSec, maxSec);
+
+    // Never plan to poll faster than the hourly request budget allows.
+    int    budget   = std::max(1, g_Settings.PollBudgetPerHour);
+    double floorSec = 3600.0 * requestsPerPoll / budget;
+    if (next < floorSec)
+    {
+        next   = floorSec;
+        reason = "budget";
+    }
+    return next;
+}
+
 void GW2Api::StartPolling(SnapshotCallback onNewSnapshot)
 {
     if (s_Running.exchange(true)) return; // already running
 
+    {
+        std::lock_guard<std::mutex> lock(s_SchedMutex);
+        s_Cancelled = false;
+    }
     s_Callback = std::move(onNewSnapshot);
 
     s_PollThread = std::thread([]()
     {
+        double      interval    = std::max(5, g_Settings.PollIntervalSec);
+        int         quietPolls  = 0;
+        bool        haveLast    = false;
+        uint64_t    lastPrint   = 0;
+        uint32_t    lastTick    = MumbleLink ? MumbleLink->UITick : 0;
+        bool        backedOff   = false; // waiting because we were out of game
+        std::deque<std::pair<Clock::time_point, int>> sent; // budget window
+        Snapshot    snap;                // kept across polls so its buffers are reused
+
+        s_EffectiveIntervalSec = (int)interval;
+
         while (s_Running.load())
         {
-            // Respect the configured interval, but allow early wakeup via PollNow()
+            // Respect the adaptive interval, but allow early wakeup via
+            // PollNow() — or as soon as the game is back after a back-off.
             {
                 std::unique_lock<std::mutex> lock(s_Mutex);
-                s_Cv.wait_for(lock,
-                    std::chrono::seconds(g_Settings.PollIntervalSec),
-                    []{ return s_PollNow || !s_Running.load(); });
+                auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                                   std::chrono::duration<double>(interval));
+                while (!s_PollNow && s_Running.load() && Clock::now() < deadline)
+                {
+                    auto slice = std::min(deadline, Clock::now() + std::chrono::seconds(ACTIVITY_CHECK_SEC));
+                    s_Cv.wait_until(lock, slice, []{ return s_PollNow || !s_Running.load(); });
+                    if (backedOff && InGame() && MumbleLink->UITick != lastTick) break;
+                }
                 s_PollNow = false;
             }
 
@@ -423,28 +1142,82 @@ void GW2Api::StartPolling(SnapshotCallback onNewSnapshot)
 
             std::string charName;
             if (MumbleIdent) charName = MumbleIdent->Name;
+            int requestsPerPoll = charName.empty() ? 4 : 5;
+
+            // ── Request budget ────────────────────────────────────────────────
+            // Holds even for PollNow(): wait until the oldest polls leave the window.
+            {
+                std::unique_lock<std::mutex> lock(s_Mutex);
+                for (;;)
+                {
+                    auto now = Clock::now();
+                    while (!sent.empty() && now - sent.front().first >= BUDGET_WINDOW)
+                        sent.pop_front();
+                    int used = 0;
+                    for (auto& e : sent) used += e.second;
+                    s_RequestsLastHour = used;
+                    if (sent.empty() || used + requestsPerPoll <= g_Settings.PollBudgetPerHour) break;
+
+                    s_IntervalReason = "budget";
+                    s_Cv.wait_until(lock, sent.front().first + BUDGET_WINDOW,
+                                    []{ return !s_Running.load(); });
+                    if (!s_Running.load()) return;
+                }
+                sent.emplace_back(Clock::now(), requestsPerPoll);
+                s_RequestsLastHour += requestsPerPoll;
+            }
+
+            PollActivity act;
+            act.inGame    = InGame();
+            act.tickAlive = MumbleLink && MumbleLink->UITick != lastTick;
+            if (MumbleLink) lastTick = MumbleLink->UITick;
 
-            Snapshot snap;
             if (FetchSnapshot(g_Settings.ApiKey, charName, snap))
             {
-                if (s_Callback) s_Callback(std::move(snap));
+                uint64_t print = Fingerprint(snap);
+                act.changed = haveLast && print != lastPrint;
+                lastPrint   = print;
+                haveLast    = true;
+                if (s_Callback) s_Callback(snap);
             }
+
+            const char* reason = "steady";
+            interval  = NextInterval(interval, act, quietPolls, requestsPerPoll, reason);
+            backedOff = !act.inGame || !act.tickAlive;
+            s_EffectiveIntervalSec = (int)(interval + 0.5);
+            s_IntervalReason       = reason;
         }
     });
 }
 
-void GW2Api::StopPolling()
+GW2Api::PollSchedule GW2Api::GetPollSchedule()
 {
-    if (!s_Running.exchange(false)) return; // wasn't running
+    PollSchedule ps;
+    ps.intervalSec      = s_EffectiveIntervalSec.load();
+    ps.reason           = s_IntervalReason.load();
+    ps.requestsLastHour = s_RequestsLastHour.load();
+    return ps;
+}
 
+void GW2Api::StopPolling()
+{
+    if (s_Running.exchange(false))
     {
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        s_PollNow = true;
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_PollNow = true;
+        }
+        s_Cv.notify_all();
+
+        if (s_PollThread.joinable())
+            s_PollThread.join();
     }
-    s_Cv.notify_all();
 
-    if (s_PollThread.joinable())
-        s_PollThread.join();
+    // Nothing calls FetchSnapshot any more.  The workers are stopped even if
+    // the poll thread never ran: FetchSnapshot may have been called directly.
+    for (Endpoint* ep : { &s_WalletEndpoint, &s_CharacterEndpoint, &s_MaterialsEndpoint,
+                          &s_BankEndpoint, &s_SharedEndpoint })
+        StopEndpoint(*ep);
 }
 
 void GW2Api::PollNow()
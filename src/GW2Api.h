@@ -50,8 +50,41 @@ namespace GW2Api
     };
 
     // ── Callbacks ─────────────────────────────────────────────────────────────
-    // Called from background thread — do NOT call ImGui from here.
-    using SnapshotCallback = std::function<void(Snapshot)>;
+    // Called from background thread — do NOT call ImGui from here.  The
+    // snapshot is the polling thread's own buffer, reused by the next poll:
+    // the callback may modify it but must not keep references into it.
+    using SnapshotCallback = std::function<void(Snapshot&)>;
+
+    // ── Request scheduling ────────────────────────────────────────────────────
+    // Every API request waits for a token from one shared rate-limit bucket.
+    // When requests queue up, lower classes wait until higher ones are served.
+    enum class RequestPriority
+    {
+        Snapshot = 0, // the five poll endpoints
+        Metadata = 1, // item / currency info for things on screen, key checks
+        Bulk     = 2, // catalog prefetch (all currencies, ...)
+    };
+
+    struct SchedulerStats
+    {
+        struct Class
+        {
+            uint32_t queued      = 0;   // requests waiting right now
+            uint64_t requests    = 0;   // requests sent so far
+            double   totalWaitMs = 0.0; // time spent waiting for a token
+            double   maxWaitMs   = 0.0;
+        };
+        Class    classes[3];     // indexed by RequestPriority
+        double   tokens    = 0;  // currently available (negative while backing off)
+        uint64_t throttled = 0;  // 429 responses seen
+    };
+    SchedulerStats GetSchedulerStats();
+
+    // Makes requests waiting for a token, and every later one, fail at once
+    // instead of sitting out a back-off.  Called first on unload, so joining
+    // the threads that make requests can't hang on the rate limit.
+    // StartPolling() lets requests through again.
+    void CancelRequests();
 
     // ── Public API ────────────────────────────────────────────────────────────
 
@@ -63,28 +96,86 @@ namespace GW2Api
                        const std::string& characterName,
                        Snapshot&          outSnapshot);
 
-    // Fetch item details for a batch of IDs (max 200 per call).
-    // Returns only the successfully fetched entries.
-    std::vector<ItemInfo> FetchItemDetails(const std::vector<int>& ids);
+    // Round-trip times of the most recent FetchSnapshot, in milliseconds.
+    // The five endpoint requests run concurrently, so totalMs tracks the
+    // slowest one; serialMs is what the same poll would cost sequentially.
+    struct PollTiming
+    {
+        double walletMs    = 0.0;
+        double characterMs = 0.0; // 0 when no character is logged in
+        double materialsMs = 0.0;
+        double bankMs      = 0.0;
+        double sharedMs    = 0.0;
+        double serialMs    = 0.0; // sum of the per-endpoint times
+        double totalMs     = 0.0; // end-to-end, including parse + merge
+
+        // Heap allocations made for this poll, on the calling thread and the
+        // endpoint workers (request, transport, parse and merge).  Counted
+        // only in builds with LOOTTRACKER_COUNT_ALLOCATIONS; 0 otherwise.
+        uint64_t allocations = 0;
+    };
+    PollTiming GetLastPollTiming();
+
+    // Snapshot endpoints send If-None-Match / If-Modified-Since and reuse the
+    // previously parsed section when nothing changed.  Running totals:
+    struct CacheStats
+    {
+        uint64_t notModified     = 0; // 304 responses
+        uint64_t identicalBodies = 0; // 200 with the same body as last time, not parsed
+        uint64_t fullParses      = 0; // bodies parsed (streamed ones always are)
+    };
+    CacheStats GetCacheStats();
+
+    // Fetch item details for any number of IDs.  IDs are sent in batches of
+    // 200, several batches in flight at once.  onBatch, if set, receives each
+    // batch's results as soon as it arrives (from a worker thread, one call at
+    // a time).  Returns only the successfully fetched entries.  IDs the API
+    // doesn't know are simply missing; IDs whose batch got no usable answer
+    // (network error, throttling, server error) are appended to *failedIds.
+    using ItemBatchCallback = std::function<void(const std::vector<ItemInfo>&)>;
+    std::vector<ItemInfo> FetchItemDetails(const std::vector<int>& ids,
+                                           RequestPriority priority = RequestPriority::Metadata,
+                                           const ItemBatchCallback& onBatch = {},
+                                           std::vector<int>* failedIds = nullptr);
 
     // Fetch currency (wallet currency type) name + icon for a set of IDs.
+    // Batched and parallel like FetchItemDetails.
     struct CurrencyInfo
     {
         int         id;
         std::string name;
         std::string iconUrl;
     };
-    std::vector<CurrencyInfo> FetchCurrencyDetails(const std::vector<int>& ids);
+    using CurrencyBatchCallback = std::function<void(const std::vector<CurrencyInfo>&)>;
+    std::vector<CurrencyInfo> FetchCurrencyDetails(const std::vector<int>& ids,
+                                                   RequestPriority priority = RequestPriority::Metadata,
+                                                   const CurrencyBatchCallback& onBatch = {},
+                                                   std::vector<int>* failedIds = nullptr);
 
     // Fetch every currency that exists in GW2 (for the profile editor).
-    // Blocking; call from a background thread.
-    std::vector<CurrencyInfo> FetchAllCurrencies();
+    // Blocking; call from a background thread.  *complete, if given, is set
+    // to whether every request succeeded, so the result is the whole list.
+    std::vector<CurrencyInfo> FetchAllCurrencies(bool* complete = nullptr);
 
-    // Start the background polling thread.
-    // onNewSnapshot is called every PollIntervalSec seconds.
+    // Start the background polling thread.  onNewSnapshot is called after
+    // every poll; the interval adapts between PollIntervalMinSec and
+    // PollIntervalMaxSec (see GetPollSchedule).
     void StartPolling(SnapshotCallback onNewSnapshot);
 
-    // Stop + join the polling thread.  Safe to call multiple times.
+    // Current adaptive poll interval and why it was chosen
+    // ("active", "steady", "idle", "out of game", "game inactive", "budget").
+    // "budget" means PollBudgetPerHour is what holds the interval up; it
+    // counts snapshot requests only, not metadata lookups.
+    struct PollSchedule
+    {
+        int         intervalSec      = 0;
+        const char* reason           = "";
+        int         requestsLastHour = 0; // snapshot requests in the rolling hour
+    };
+    PollSchedule GetPollSchedule();
+
+    // Stop + join the polling thread and the snapshot endpoint workers (also
+    // those a direct FetchSnapshot started).  Safe to call multiple times.
     void StopPolling();
 
     // Poke the polling thread to fire immediately (e.g., on session start).
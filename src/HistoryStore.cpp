@@ -0,0 +1,390 @@
+#include "HistoryStore.h"
+
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+using json = nlohmann::json;
+
+// ── File layout ───────────────────────────────────────────────────────────────
+
+static const char     MAGIC[4] = { 'L', 'T', 'H', 'S' };
+static const uint32_t VERSION  = 1;
+
+#pragma pack(push, 1)
+struct SegmentHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t firstOrdinal;
+    uint32_t sessionCount;
+    uint32_t itemDictCount;
+    uint32_t currencyDictCount;
+    uint32_t indexOffset;   // session index; dictionaries start right after this header
+};
+#pragma pack(pop)
+
+// ── Encoding ──────────────────────────────────────────────────────────────────
+
+static void PutVar(std::string& buf, uint64_t v)
+{
+    while (v >= 0x80) { buf.push_back((char)(v | 0x80)); v >>= 7; }
+    buf.push_back((char)v);
+}
+
+static void PutSVar(std::string& buf, int64_t v)
+{
+    PutVar(buf, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63)); // zigzag
+}
+
+static void PutStr(std::string& buf, std::string_view s)
+{
+    PutVar(buf, s.size());
+    buf.append(s.data(), s.size());
+}
+
+static void PutStr(std::string& buf, const std::string& s) { PutStr(buf, std::string_view(s)); }
+
+static void PutU32At(std::string& buf, size_t at, uint32_t v) { memcpy(&buf[at], &v, 4); }
+
+std::string HistoryStore::Encode(const std::vector<const SessionHistory::SavedSession*>& sessions,
+                                 uint32_t firstOrdinal)
+{
+    // Dictionaries: each distinct catalog entry once, in first-use order.
+    std::unordered_map<const Catalog::Item*, uint32_t>     itemIdx;
+    std::unordered_map<const Catalog::Currency*, uint32_t> currencyIdx;
+    std::vector<const Catalog::Item*>                      items;
+    std::vector<const Catalog::Currency*>                  currencies;
+    for (auto* s : sessions)
+    {
+        for (auto& d : s->items)
+            if (itemIdx.emplace(d.info, (uint32_t)items.size()).second) items.push_back(d.info);
+        for (auto& c : s->currencies)
+            if (currencyIdx.emplace(c.info, (uint32_t)currencies.size()).second)
+                currencies.push_back(c.info);
+    }
+
+    std::string buf(sizeof(SegmentHeader), '\0');
+
+    for (auto* info : items)
+    {
+        PutVar(buf, (uint32_t)info->id);
+        PutStr(buf, info->name);
+        PutStr(buf, Catalog::RarityName(*info));
+        PutStr(buf, Catalog::TypeName(*info));
+        PutStr(buf, info->description);
+        PutSVar(buf, info->vendorValue);
+    }
+    for (auto* info : currencies)
+    {
+        PutVar(buf, (uint32_t)info->id);
+        PutStr(buf, info->name);
+    }
+
+    const size_t indexOffset = buf.size();
+    buf.resize(buf.size() + sessions.size() * 8);
+
+    for (size_t i = 0; i < sessions.size(); ++i)
+    {
+        const SessionHistory::SavedSession& s = *sessions[i];
+
+        PutU32At(buf, indexOffset + i * 8, (uint32_t)buf.size());
+        PutStr(buf, s.label);
+        PutStr(buf, s.startTimestamp);
+        PutStr(buf, s.endTimestamp);
+        PutVar(buf, s.items.size());
+        PutVar(buf, s.currencies.size());
+
+        SessionHistory::SessionSummary sum = SessionHistory::Summarize(s, firstOrdinal + i);
+        PutSVar(buf, sum.goldDelta);
+        PutVar(buf, sum.itemCount);
+        PutVar(buf, sum.topItems.size());
+        for (auto& d : sum.topItems)
+        {
+            PutVar(buf, itemIdx[d.info]);
+            PutSVar(buf, d.delta);
+        }
+
+        PutU32At(buf, indexOffset + i * 8 + 4, (uint32_t)buf.size());
+        for (auto& d : s.items)      PutVar(buf, itemIdx[d.info]);
+        for (auto& d : s.items)      PutSVar(buf, d.delta);
+        for (auto& c : s.currencies) PutVar(buf, currencyIdx[c.info]);
+        for (auto& c : s.currencies) PutSVar(buf, c.delta);
+    }
+
+    SegmentHeader hdr;
+    memcpy(hdr.magic, MAGIC, 4);
+    hdr.version           = VERSION;
+    hdr.firstOrdinal      = firstOrdinal;
+    hdr.sessionCount      = (uint32_t)sessions.size();
+    hdr.itemDictCount     = (uint32_t)items.size();
+    hdr.currencyDictCount = (uint32_t)currencies.size();
+    hdr.indexOffset       = (uint32_t)indexOffset;
+    memcpy(&buf[0], &hdr, sizeof(hdr));
+    return buf;
+}
+
+// ── Decoding ──────────────────────────────────────────────────────────────────
+
+namespace
+{
+    // Bounds-checked cursor over a mapped segment.
+    struct Reader
+    {
+        const char* p;
+        const char* end;
+        bool        ok = true;
+
+        uint64_t Var()
+        {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                if (p >= end) { ok = false; return 0; }
+                uint8_t b = (uint8_t)*p++;
+                v |= (uint64_t)(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+
+        int64_t SVar()
+        {
+            uint64_t v = Var();
+            return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+        }
+
+        std::string_view Str()
+        {
+            uint64_t len = Var();
+            if (!ok || (uint64_t)(end - p) < len) { ok = false; return {}; }
+            std::string_view s(p, (size_t)len);
+            p += len;
+            return s;
+        }
+    };
+}
+
+std::shared_ptr<const HistoryStore::Segment> HistoryStore::Segment::Open(const std::string& path)
+{
+    std::shared_ptr<Segment> seg(new Segment());
+
+    if (!seg->m_File.Open(path) || seg->m_File.Size() < sizeof(SegmentHeader)) return nullptr;
+    seg->m_Data = seg->m_File.Data();
+    seg->m_Size = seg->m_File.Size();
+
+    SegmentHeader hdr;
+    memcpy(&hdr, seg->m_Data, sizeof(hdr));
+    if (memcmp(hdr.magic, MAGIC, 4) != 0 || hdr.version != VERSION)
+        return nullptr;
+    if (hdr.indexOffset > seg->m_Size ||
+        (uint64_t)hdr.sessionCount * 8 > seg->m_Size - hdr.indexOffset)
+        return nullptr;
+    seg->m_FirstOrdinal = hdr.firstOrdinal;
+
+    // Dictionaries: every record is at least two bytes, so cap the reserve.
+    Reader r{ seg->m_Data + sizeof(hdr), seg->m_Data + hdr.indexOffset };
+    seg->m_Items.reserve(std::min<size_t>(hdr.itemDictCount, seg->m_Size / 2));
+    for (uint32_t i = 0; i < hdr.itemDictCount && r.ok; ++i)
+    {
+        GW2Api::ItemInfo info;
+        info.id          = (int)r.Var();
+        info.name        = std::string(r.Str());
+        info.rarity      = std::string(r.Str());
+        info.type        = std::string(r.Str());
+        info.description = std::string(r.Str());
+        info.vendorValue = (int)r.SVar();
+        if (r.ok) seg->m_Items.push_back(Catalog::RestoreItem(info));
+    }
+    seg->m_Currencies.reserve(std::min<size_t>(hdr.currencyDictCount, seg->m_Size / 2));
+    for (uint32_t i = 0; i < hdr.currencyDictCount && r.ok; ++i)
+    {
+        GW2Api::CurrencyInfo info;
+        info.id   = (int)r.Var();
+        info.name = std::string(r.Str());
+        if (r.ok) seg->m_Currencies.push_back(Catalog::RestoreCurrency(info));
+    }
+    if (!r.ok) return nullptr;
+
+    seg->m_Index.resize(hdr.sessionCount);
+    memcpy(seg->m_Index.data(), seg->m_Data + hdr.indexOffset, hdr.sessionCount * 8);
+    for (auto& e : seg->m_Index)
+        if (e.header >= seg->m_Size || e.body > seg->m_Size) return nullptr;
+
+    return seg;
+}
+
+bool HistoryStore::Segment::DecodeSummary(uint32_t i, SessionHistory::SessionSummary& out) const
+{
+    if (i >= m_Index.size()) return false;
+
+    Reader r{ m_Data + m_Index[i].header, m_Data + m_Size };
+    out.label          = std::string(r.Str());
+    out.startTimestamp = std::string(r.Str());
+    out.endTimestamp   = std::string(r.Str());
+    r.Var(); // rows in the body
+    out.currencyCount  = (uint32_t)r.Var();
+    out.goldDelta      = r.SVar();
+    out.itemCount      = (uint32_t)r.Var();
+
+    uint64_t top = r.Var();
+    if (!r.ok || top > SessionHistory::TOP_ITEMS) return false;
+    out.topItems.resize((size_t)top);
+    for (auto& d : out.topItems)
+    {
+        uint64_t k = r.Var();
+        if (k >= m_Items.size()) return false;
+        d.info  = m_Items[(size_t)k];
+        d.id    = d.info->id;
+        d.delta = (int)r.SVar();
+    }
+    return r.ok;
+}
+
+bool HistoryStore::Segment::Decode(uint32_t i, SessionHistory::SavedSession& out) const
+{
+    if (i >= m_Index.size()) return false;
+
+    // Counts follow the strings in the header record.
+    Reader h{ m_Data + m_Index[i].header, m_Data + m_Size };
+    out.label          = std::string(h.Str());
+    out.startTimestamp = std::string(h.Str());
+    out.endTimestamp   = std::string(h.Str());
+    uint64_t itemCount     = h.Var();
+    uint64_t currencyCount = h.Var();
+    if (!h.ok) return false;
+
+    Reader r{ m_Data + m_Index[i].body, m_Data + m_Size };
+    // Each value takes at least a byte; don't trust counts beyond that.
+    const uint64_t left = (uint64_t)(r.end - r.p);
+    if (itemCount > left || currencyCount > left || (itemCount + currencyCount) * 2 > left)
+        return false;
+
+    out.items.resize((size_t)itemCount);
+    for (auto& d : out.items)
+    {
+        uint64_t k = r.Var();
+        if (k >= m_Items.size()) return false;
+        d.info = m_Items[(size_t)k];
+        d.id   = d.info->id;
+    }
+    for (auto& d : out.items) d.delta = (int)r.SVar();
+
+    out.currencies.resize((size_t)currencyCount);
+    for (auto& c : out.currencies)
+    {
+        uint64_t k = r.Var();
+        if (k >= m_Currencies.size()) return false;
+        c.info = m_Currencies[(size_t)k];
+        c.id   = c.info->id;
+    }
+    for (auto& c : out.currencies) c.delta = r.SVar();
+    return r.ok;
+}
+
+// ── JSON ──────────────────────────────────────────────────────────────────────
+
+json HistoryStore::ToJson(const SessionHistory::SavedSession& s)
+{
+    json sess;
+    sess["label"]          = s.label;
+    sess["startTimestamp"] = s.startTimestamp;
+    sess["endTimestamp"]   = s.endTimestamp;
+
+    json items = json::array();
+    for (auto& item : s.items)
+    {
+        json j;
+        j["id"]          = item.id;
+        j["name"]        = std::string(item.info->name);
+        j["rarity"]      = std::string(Catalog::RarityName(*item.info));
+        j["delta"]       = item.delta;
+        j["type"]        = std::string(Catalog::TypeName(*item.info));
+        j["description"] = std::string(item.info->description);
+        j["vendorValue"] = item.info->vendorValue;
+        items.push_back(std::move(j));
+    }
+    sess["items"] = std::move(items);
+
+    json currencies = json::array();
+    for (auto& c : s.currencies)
+    {
+        json j;
+        j["id"]    = c.id;
+        j["name"]  = std::string(c.info->name);
+        j["delta"] = c.delta;
+        currencies.push_back(std::move(j));
+    }
+    sess["currencies"] = std::move(currencies);
+    return sess;
+}
+
+SessionHistory::SavedSession HistoryStore::FromJson(const json& sess, size_t& rows)
+{
+    SessionHistory::SavedSession s;
+    s.label          = sess.value("label",          "");
+    s.startTimestamp = sess.value("startTimestamp", "");
+    s.endTimestamp   = sess.value("endTimestamp",   "");
+
+    for (auto& jitem : sess.value("items", json::array()))
+    {
+        GW2Api::ItemInfo info{};
+        info.id          = jitem.value("id",          0);
+        info.name        = jitem.value("name",        "");
+        info.rarity      = jitem.value("rarity",      "");
+        info.type        = jitem.value("type",        "");
+        info.description = jitem.value("description", "");
+        info.vendorValue = jitem.value("vendorValue", 0);
+
+        LootSession::ItemDelta d;
+        d.id    = info.id;
+        d.delta = jitem.value("delta", 0);
+        d.info  = Catalog::RestoreItem(info);
+        s.items.push_back(d);
+
+        ++rows;
+    }
+
+    for (auto& jc : sess.value("currencies", json::array()))
+    {
+        GW2Api::CurrencyInfo info{};
+        info.id   = jc.value("id",   0);
+        info.name = jc.value("name", "");
+
+        LootSession::CurrencyDelta c;
+        c.id    = info.id;
+        c.delta = jc.value("delta", (int64_t)0);
+        c.info  = Catalog::RestoreCurrency(info);
+        s.currencies.push_back(c);
+
+        ++rows;
+    }
+    return s;
+}
+
+// ── Summaries ─────────────────────────────────────────────────────────────────
+
+SessionHistory::SessionSummary SessionHistory::Summarize(const SavedSession& s, size_t ordinal)
+{
+    SessionSummary sum;
+    sum.ordinal        = ordinal;
+    sum.label          = s.label;
+    sum.startTimestamp = s.startTimestamp;
+    sum.endTimestamp   = s.endTimestamp;
+    sum.currencyCount  = (uint32_t)s.currencies.size();
+    for (auto& d : s.items)
+        if (d.delta != 0) ++sum.itemCount;
+    for (auto& c : s.currencies)
+        if (c.id == 1) sum.goldDelta += c.delta;
+
+    // Largest gains; ties by ID so a session always summarizes the same way.
+    for (auto& d : s.items)
+        if (d.delta > 0) sum.topItems.push_back(d);
+    size_t top = std::min(TOP_ITEMS, sum.topItems.size());
+    std::partial_sort(sum.topItems.begin(), sum.topItems.begin() + top, sum.topItems.end(),
+        [](const LootSession::ItemDelta& a, const LootSession::ItemDelta& b)
+        { return a.delta != b.delta ? a.delta > b.delta : a.id < b.id; });
+    sum.topItems.resize(top);
+    return sum;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "SessionHistory.h"
+#include "MappedFile.h"
+
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// ── Binary columnar history segments ──────────────────────────────────────────
+// A sealed run of saved sessions in one file (history-NNNNNN.lth):
+//
+//   SegmentHeader
+//   item dictionary      × { vid, str name, str rarity, str type, str description,
+//                            svarint vendorValue }
+//   currency dictionary  × { vid, str name }
+//   session index        × { u32 headerOffset, u32 bodyOffset }
+//   per session: header  { str label, str start, str end, vcount items, vcount currencies,
+//                          sv goldDelta, vcount non-zero items,
+//                          vcount top, top × { v item dict index, sv delta } }
+//                body    { item dict indices[], item deltas[],
+//                          currency dict indices[], currency deltas[] }
+//
+// v = unsigned LEB128 varint, sv = zigzag varint, str = varint length + UTF-8.
+// Item and currency info is written once per segment in the dictionaries;
+// session bodies are columns of small integers.
+//
+// The header carries the session's summary, so listing history reads headers
+// only.
+//
+// Segments are memory-mapped.  Opening one decodes only the dictionaries and
+// the session index; headers and bodies are decoded when asked for.
+//
+// The JSON form of a session is kept here too: it is a history.log line, and
+// how the older history.json is imported.
+namespace HistoryStore
+{
+    nlohmann::json ToJson(const SessionHistory::SavedSession& s);
+
+    // Restores the session's item and currency info into the catalog.  Adds
+    // the item and currency rows read to rows.
+    SessionHistory::SavedSession FromJson(const nlohmann::json& j, size_t& rows);
+
+    // Encodes sessions (oldest first) as a segment image.  firstOrdinal is the
+    // position of sessions[0] in the whole history.
+    std::string Encode(const std::vector<const SessionHistory::SavedSession*>& sessions,
+                       uint32_t firstOrdinal);
+
+    class Segment
+    {
+    public:
+        // Maps path and decodes its dictionaries into the catalog.  Returns
+        // null if the file is missing, truncated or not a segment.
+        static std::shared_ptr<const Segment> Open(const std::string& path);
+        Segment(const Segment&) = delete;
+        Segment& operator=(const Segment&) = delete;
+
+        uint32_t FirstOrdinal() const { return m_FirstOrdinal; }
+        uint32_t Size()         const { return (uint32_t)m_Index.size(); }
+        size_t   FileBytes()    const { return m_Size; }
+
+        // Header fields only; out.ordinal is left as the caller set it.
+        bool DecodeSummary(uint32_t i, SessionHistory::SessionSummary& out) const;
+        // The whole session, items and currencies included.
+        bool Decode(uint32_t i, SessionHistory::SavedSession& out) const;
+
+    private:
+        Segment() = default;
+
+        struct IndexEntry { uint32_t header, body; };
+
+        MappedFile  m_File;
+        const char* m_Data = nullptr; // m_File's view
+        size_t      m_Size = 0;
+
+        uint32_t                               m_FirstOrdinal = 0;
+        std::vector<IndexEntry>                m_Index;
+        std::vector<const Catalog::Item*>      m_Items;
+        std::vector<const Catalog::Currency*>  m_Currencies;
+    };
+}
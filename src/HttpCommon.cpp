@@ -0,0 +1,245 @@
+#include "HttpTransport.h"
+
+#include <zlib.h>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <new>
+#include <algorithm>
+
+// Everything here is shared by the transports and builds on any platform;
+// the WinHTTP backend itself is in HttpTransport.cpp.
+
+// ── Content-Encoding decoding ─────────────────────────────────────────────────
+
+static std::atomic<uint64_t> s_Responses           { 0 };
+static std::atomic<uint64_t> s_CompressedResponses { 0 };
+static std::atomic<uint64_t> s_WireBytes           { 0 };
+static std::atomic<uint64_t> s_DecodedBytes        { 0 };
+
+struct Http::BodyDecoder::Impl
+{
+    enum class Mode { Identity, Gzip, Deflate, Unsupported };
+
+    Mode        mode = Mode::Identity;
+    const Sink* sink = nullptr;
+    z_stream    zs{};
+    bool        initialised = false; // inflateInit done; later bodies only reset
+    bool        started  = false;    // current body's inflate stream is set up
+    bool        ended    = false;    // Z_STREAM_END seen
+    bool        failed   = false;
+    bool        anyInput = false;
+    unsigned char head[2];           // deflate: first bytes, held until the format is known
+    size_t        headLen = 0;
+    unsigned char out[16 * 1024];
+
+    ~Impl() { if (initialised) inflateEnd(&zs); }
+
+    // zlib allocates its state once and its window on first use.  Routed
+    // through operator new so AllocCounter sees them.
+    static voidpf Alloc(voidpf, uInt items, uInt size)
+    {
+        return ::operator new((size_t)items * size, std::nothrow);
+    }
+    static void Free(voidpf, voidpf p) { ::operator delete(p); }
+
+    // "deflate" is meant to be zlib-wrapped, but some servers send raw
+    // deflate.  A zlib header has CM = 8 and a header checksum divisible by 31.
+    static bool LooksLikeZlib(const unsigned char* p, size_t len)
+    {
+        return len >= 2 && (p[0] & 0x0F) == 8 && ((p[0] << 8) | p[1]) % 31 == 0;
+    }
+
+    bool Inflate(const char* data, size_t len)
+    {
+        if (!started)
+        {
+            int windowBits = 15 + 32; // auto-detect gzip / zlib header
+            if (mode == Mode::Deflate)
+            {
+                // Need the first two bytes to tell zlib from raw deflate.
+                while (headLen < 2 && len > 0) { head[headLen++] = *data++; --len; }
+                if (headLen < 2) return true;
+                if (!LooksLikeZlib(head, 2)) windowBits = -15;
+            }
+            if (!initialised)
+            {
+                zs.zalloc = Alloc;
+                zs.zfree  = Free;
+                if (inflateInit2(&zs, windowBits) != Z_OK) return false;
+                initialised = true;
+            }
+            else if (inflateReset2(&zs, windowBits) != Z_OK)
+                return false;
+            started = true;
+            if (headLen && !Run((const char*)head, headLen)) return false;
+        }
+        return Run(data, len);
+    }
+
+    bool Run(const char* data, size_t len)
+    {
+        zs.next_in  = (Bytef*)data;
+        zs.avail_in = (uInt)len;
+        while (!ended)
+        {
+            zs.next_out  = out;
+            zs.avail_out = sizeof(out);
+            int rc = inflate(&zs, Z_NO_FLUSH);
+            if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) return false;
+
+            size_t produced = sizeof(out) - zs.avail_out;
+            if (produced)
+            {
+                s_DecodedBytes += produced;
+                (*sink)((const char*)out, produced);
+            }
+            if (rc == Z_STREAM_END) ended = true;
+            else if (zs.avail_in == 0 && zs.avail_out != 0) break; // need more input
+            else if (rc == Z_BUF_ERROR && produced == 0) return false;
+        }
+        return true;
+    }
+};
+
+Http::BodyDecoder::BodyDecoder()  = default;
+Http::BodyDecoder::~BodyDecoder() = default;
+
+void Http::BodyDecoder::Begin(const std::string& contentEncoding, const Sink& sink)
+{
+    if (!m_Impl) m_Impl = std::make_unique<Impl>();
+    Impl& d = *m_Impl;
+
+    // Lower-cased and truncated; a truncated value never matches a known name.
+    char   enc[16];
+    size_t n = 0;
+    for (char c : contentEncoding)
+        if (c != ' ' && c != '\t' && n < sizeof(enc))
+            enc[n++] = (char)tolower((unsigned char)c);
+    std::string_view e(enc, n);
+
+    using Mode = Impl::Mode;
+    if      (e.empty() || e == "identity") d.mode = Mode::Identity;
+    else if (e == "gzip" || e == "x-gzip") d.mode = Mode::Gzip;
+    else if (e == "deflate")               d.mode = Mode::Deflate;
+    else                                   d.mode = Mode::Unsupported;
+
+    d.sink     = &sink;
+    d.started  = false;
+    d.ended    = false;
+    d.failed   = false;
+    d.anyInput = false;
+    d.headLen  = 0;
+
+    ++s_Responses;
+    if (d.mode == Mode::Gzip || d.mode == Mode::Deflate)
+        ++s_CompressedResponses;
+}
+
+bool Http::BodyDecoder::IsIdentity() const
+{
+    return m_Impl && m_Impl->mode == Impl::Mode::Identity;
+}
+
+bool Http::BodyDecoder::Write(const char* data, size_t len)
+{
+    Impl& d = *m_Impl;
+    if (d.failed || len == 0) return !d.failed;
+    d.anyInput = true;
+    s_WireBytes += len;
+
+    switch (d.mode)
+    {
+    case Impl::Mode::Identity:
+        s_DecodedBytes += len;
+        (*d.sink)(data, len);
+        return true;
+    case Impl::Mode::Gzip:
+    case Impl::Mode::Deflate:
+        if (d.Inflate(data, len)) return true;
+        break;
+    default:
+        break;
+    }
+    d.failed = true;
+    return false;
+}
+
+bool Http::BodyDecoder::Finish()
+{
+    Impl& d = *m_Impl;
+    if (d.failed) return false;
+    if (d.mode == Impl::Mode::Identity || !d.anyInput) return true;
+    return d.ended;
+}
+
+void Http::CountIdentityBytes(size_t len)
+{
+    s_WireBytes    += len;
+    s_DecodedBytes += len;
+}
+
+// ── Response arena ────────────────────────────────────────────────────────────
+
+char* Http::ResponseArena::Reserve(size_t n)
+{
+    if (m_Capacity - m_Size < n)
+    {
+        // Grow once to what is needed (or double), keeping the contents.
+        size_t cap = std::max(m_Size + n, m_Capacity * 2);
+        std::unique_ptr<char[]> data(new char[cap]);
+        if (m_Size) memcpy(data.get(), m_Data.get(), m_Size);
+        m_Data     = std::move(data);
+        m_Capacity = cap;
+    }
+    return m_Data.get() + m_Size;
+}
+
+void Http::ResponseArena::Append(const char* data, size_t len)
+{
+    memcpy(Reserve(len), data, len);
+    Commit(len);
+}
+
+Http::TransferStats Http::GetTransferStats()
+{
+    TransferStats st;
+    st.responses           = s_Responses.load();
+    st.compressedResponses = s_CompressedResponses.load();
+    st.wireBytes           = s_WireBytes.load();
+    st.decodedBytes        = s_DecodedBytes.load();
+    return st;
+}
+
+// ── Process-wide transport ────────────────────────────────────────────────────
+
+static std::mutex                        s_Mutex;
+static std::shared_ptr<Http::ITransport> s_Transport;
+
+std::shared_ptr<Http::ITransport> Http::GetTransport()
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+#ifdef _WIN32
+    if (!s_Transport)
+        s_Transport = CreateWinHttpTransport(L"api.guildwars2.com", 443, true);
+#endif
+    return s_Transport;
+}
+
+void Http::SetTransport(std::shared_ptr<ITransport> transport)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    s_Transport = std::move(transport);
+}
+
+void Http::Shutdown()
+{
+    std::shared_ptr<ITransport> t;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        t = s_Transport;
+    }
+    if (t) t->Close();
+}
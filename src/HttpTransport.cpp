@@ -0,0 +1,248 @@
+#include "HttpTransport.h"
+
+#include <windows.h>
+#include <winhttp.h>
+#include <string>
+#include <mutex>
+#include <algorithm>
+
+// ── WinHTTP transport ─────────────────────────────────────────────────────────
+
+// WinHTTP pools keep-alive sockets per session handle.  Allow enough of them
+// that concurrent requests to the same host don't queue behind each other.
+static const DWORD MAX_CONNS_PER_SERVER = 8;
+
+// Reads a string response header (ETag, Last-Modified, ...) into value,
+// reusing its buffer.  Header values we care about are plain ASCII, so
+// narrowing is lossless.
+static void QueryHeader(HINTERNET hReq, DWORD query, std::string& value)
+{
+    value.clear();
+    wchar_t buf[256];
+    DWORD   size = sizeof(buf);
+    if (!WinHttpQueryHeaders(hReq, query, WINHTTP_HEADER_NAME_BY_INDEX,
+                             buf, &size, WINHTTP_NO_HEADER_INDEX))
+        return;
+    size /= sizeof(wchar_t);
+    for (DWORD i = 0; i < size; ++i) value += (char)buf[i];
+}
+
+namespace
+{
+    // Session + connect handle pair.  Shared by every in-flight request, so
+    // Close() can drop it while a request is still using it — the handles are
+    // released when the last request finishes.
+    struct Connection
+    {
+        HINTERNET hSession = nullptr;
+        HINTERNET hConnect = nullptr;
+
+        ~Connection()
+        {
+            if (hConnect) WinHttpCloseHandle(hConnect);
+            if (hSession) WinHttpCloseHandle(hSession);
+        }
+    };
+
+    class WinHttpTransport : public Http::ITransport
+    {
+    public:
+        WinHttpTransport(std::wstring host, int port, bool secure)
+            : m_Host(std::move(host)), m_Port(port), m_Secure(secure) {}
+
+        bool Get(const Http::Request& req, Http::Response& out) override
+        {
+            out.status = 0;
+            out.body.clear();
+            out.etag.clear();
+            out.lastModified.clear();
+
+            std::shared_ptr<Connection>         conn = Acquire();
+            std::shared_ptr<const std::wstring> auth = AuthHeader(req.apiKey);
+            if (!conn) return false;
+
+            HINTERNET hReq = WinHttpOpenRequest(
+                conn->hConnect,
+                L"GET",
+                req.path.c_str(),
+                nullptr,
+                WINHTTP_NO_REFERER,
+                WINHTTP_DEFAULT_ACCEPT_TYPES,
+                m_Secure ? WINHTTP_FLAG_SECURE : 0);
+            if (!hReq) return false;
+
+            if (auth)
+                WinHttpAddRequestHeaders(hReq, auth->c_str(), (DWORD)-1,
+                                         WINHTTP_ADDREQ_FLAG_ADD);
+            WinHttpAddRequestHeaders(hReq, L"Accept-Encoding: gzip, deflate", (DWORD)-1,
+                                     WINHTTP_ADDREQ_FLAG_ADD);
+
+            if (!req.ifNoneMatch.empty())
+            {
+                std::wstring h = L"If-None-Match: " +
+                    std::wstring(req.ifNoneMatch.begin(), req.ifNoneMatch.end());
+                WinHttpAddRequestHeaders(hReq, h.c_str(), (DWORD)-1, WINHTTP_ADDREQ_FLAG_ADD);
+            }
+            if (!req.ifModifiedSince.empty())
+            {
+                std::wstring h = L"If-Modified-Since: " +
+                    std::wstring(req.ifModifiedSince.begin(), req.ifModifiedSince.end());
+                WinHttpAddRequestHeaders(hReq, h.c_str(), (DWORD)-1, WINHTTP_ADDREQ_FLAG_ADD);
+            }
+
+            bool ok = false;
+            BOOL sent = WinHttpSendRequest(hReq,
+                WINHTTP_NO_ADDITIONAL_HEADERS, 0,
+                WINHTTP_NO_REQUEST_DATA, 0, 0, 0);
+
+            if (sent && WinHttpReceiveResponse(hReq, nullptr))
+            {
+                DWORD statusCode = 0;
+                DWORD statusSize = sizeof(statusCode);
+                WinHttpQueryHeaders(hReq,
+                    WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+                    WINHTTP_HEADER_NAME_BY_INDEX,
+                    &statusCode, &statusSize,
+                    WINHTTP_NO_HEADER_INDEX);
+                out.status       = (int)statusCode;
+                QueryHeader(hReq, WINHTTP_QUERY_ETAG,          out.etag);
+                QueryHeader(hReq, WINHTTP_QUERY_LAST_MODIFIED, out.lastModified);
+
+                bool stream   = !req.raw && req.onData && statusCode >= 200 && statusCode < 300;
+                bool toArena  = !req.raw && req.arena && !stream;
+                Http::BodyDecoder::Sink toBody = [&out, &req](const char* data, size_t len)
+                {
+                    if (req.arena) req.arena->Append(data, len);
+                    else           out.body.append(data, len);
+                };
+
+                Http::BodyDecoder  ownDecoder;
+                Http::BodyDecoder& decoder = req.arena ? req.arena->Decoder() : ownDecoder;
+                std::string encoding;
+                QueryHeader(hReq, WINHTTP_QUERY_CONTENT_ENCODING, encoding);
+                if (req.raw) out.contentEncoding = encoding;
+                else         decoder.Begin(encoding, stream ? req.onData : toBody);
+
+                // Presize from Content-Length.  For a compressed body that is
+                // only a lower bound; the arena keeps last poll's capacity anyway.
+                if (toArena)
+                {
+                    req.arena->Clear();
+                    DWORD contentLength = 0;
+                    DWORD lengthSize    = sizeof(contentLength);
+                    if (WinHttpQueryHeaders(hReq,
+                            WINHTTP_QUERY_CONTENT_LENGTH | WINHTTP_QUERY_FLAG_NUMBER,
+                            WINHTTP_HEADER_NAME_BY_INDEX,
+                            &contentLength, &lengthSize,
+                            WINHTTP_NO_HEADER_INDEX))
+                        req.arena->Reserve(contentLength);
+                }
+                bool direct = toArena && decoder.IsIdentity();
+
+                // Always drain the body, even on errors — a half-read response
+                // can't go back into the keep-alive pool.  Identity bodies bound
+                // for an arena are read straight into it; everything else goes
+                // through a fixed buffer into the decoder.
+                bool  decoded = true;
+                char  chunk[16 * 1024];
+                DWORD bytesAvail = 0;
+                while (WinHttpQueryDataAvailable(hReq, &bytesAvail) && bytesAvail > 0)
+                {
+                    DWORD bytesRead = 0;
+                    if (direct)
+                    {
+                        if (!WinHttpReadData(hReq, req.arena->Reserve(bytesAvail),
+                                             bytesAvail, &bytesRead))
+                        {
+                            decoded = false;
+                            break;
+                        }
+                        req.arena->Commit(bytesRead);
+                        Http::CountIdentityBytes(bytesRead);
+                        continue;
+                    }
+                    if (!WinHttpReadData(hReq, chunk,
+                                         std::min<DWORD>(bytesAvail, sizeof(chunk)), &bytesRead))
+                    {
+                        decoded = false;
+                        break;
+                    }
+                    if (req.raw)      out.body.append(chunk, bytesRead);
+                    else if (decoded) decoded = decoder.Write(chunk, bytesRead);
+                }
+
+                // A body that can't be decoded is as good as no response.
+                ok = (req.raw || decoder.Finish()) && decoded;
+            }
+
+            WinHttpCloseHandle(hReq);
+            return ok;
+        }
+
+        void Close() override
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Conn.reset();
+        }
+
+    private:
+        // Returns the shared connection, opening the session on first use.
+        std::shared_ptr<Connection> Acquire()
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Conn) return m_Conn;
+
+            auto conn = std::make_shared<Connection>();
+            conn->hSession = WinHttpOpen(
+                L"LootTracker/1.0",
+                WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+                WINHTTP_NO_PROXY_NAME,
+                WINHTTP_NO_PROXY_BYPASS,
+                0);
+            if (!conn->hSession) return nullptr;
+
+            DWORD maxConns = MAX_CONNS_PER_SERVER;
+            WinHttpSetOption(conn->hSession, WINHTTP_OPTION_MAX_CONNS_PER_SERVER,
+                             &maxConns, sizeof(maxConns));
+
+            conn->hConnect = WinHttpConnect(conn->hSession, m_Host.c_str(),
+                                            (INTERNET_PORT)m_Port, 0);
+            if (!conn->hConnect) return nullptr;
+
+            m_Conn = conn;
+            return m_Conn;
+        }
+
+        // "Authorization: Bearer <key>" is rebuilt only when the key changes.
+        std::shared_ptr<const std::wstring> AuthHeader(const std::string& apiKey)
+        {
+            if (apiKey.empty()) return nullptr;
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (!m_Auth || apiKey != m_AuthKey)
+            {
+                m_AuthKey = apiKey;
+                m_Auth    = std::make_shared<const std::wstring>(
+                    L"Authorization: Bearer " + std::wstring(apiKey.begin(), apiKey.end()));
+            }
+            return m_Auth;
+        }
+
+        const std::wstring m_Host;
+        const int          m_Port;
+        const bool         m_Secure;
+
+        std::mutex                          m_Mutex;
+        std::shared_ptr<Connection>         m_Conn;
+        std::string                         m_AuthKey;
+        std::shared_ptr<const std::wstring> m_Auth;
+    };
+}
+
+std::unique_ptr<Http::ITransport> Http::CreateWinHttpTransport(const std::wstring& host,
+                                                               int                 port,
+                                                               bool                secure)
+{
+    return std::make_unique<WinHttpTransport>(host, port, secure);
+}
+
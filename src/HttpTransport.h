@@ -0,0 +1,181 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace Http
+{
+    class ResponseArena;
+
+    // ── Request / response ────────────────────────────────────────────────────
+
+    struct Request
+    {
+        std::wstring path;    // e.g. L"/v2/account/bank"
+        std::string  apiKey;  // sent as "Authorization: Bearer <key>" when set
+
+        // Validators from a previous response.  When set, they are sent as
+        // If-None-Match / If-Modified-Since and the server may answer 304.
+        std::string  ifNoneMatch;
+        std::string  ifModifiedSince;
+
+        // Optional body sink.  When set, the body of a 2xx response is handed
+        // over chunk by chunk as it is read — so it can be parsed while the
+        // rest is still in flight — and Response::body stays empty.
+        std::function<void(const char* data, size_t len)> onData;
+
+        // Optional reusable storage.  When set, a buffered body lands in the
+        // arena instead of Response::body, and the arena's inflate state is
+        // reused.  Must not be shared by two requests in flight at once.
+        ResponseArena* arena = nullptr;
+
+        // Return the body exactly as received, still Content-Encoded, in
+        // Response::body; onData and arena are ignored.  For the recording
+        // transport, whose replay decodes it later.
+        bool raw = false;
+    };
+
+    struct Response
+    {
+        int         status = 0; // HTTP status code (304 = not modified)
+        std::string body;
+        std::string etag;         // ETag header, if any
+        std::string lastModified; // Last-Modified header, if any
+        std::string contentEncoding; // Content-Encoding header, for a raw request
+    };
+
+    // ── Content-Encoding ──────────────────────────────────────────────────────
+    // Every request advertises "Accept-Encoding: gzip, deflate"; the JSON the
+    // API returns is very repetitive and typically shrinks 5-10x.  Transports
+    // push the raw bytes they read through a BodyDecoder, which inflates them
+    // block by block into the sink — the compressed body is never buffered.
+    class BodyDecoder
+    {
+    public:
+        using Sink = std::function<void(const char* data, size_t len)>;
+
+        BodyDecoder();
+        ~BodyDecoder();
+
+        // Start decoding a new body.  contentEncoding is the response's
+        // Content-Encoding header value; empty or "identity" passes bytes
+        // through unchanged.  sink must outlive the body.  Inflate state from
+        // the previous body is reset rather than reallocated.
+        void Begin(const std::string& contentEncoding, const Sink& sink);
+
+        // True when the current body passes through unchanged.
+        bool IsIdentity() const;
+
+        // Feed the next chunk read off the wire.  Returns false on corrupt
+        // data or an unsupported encoding; later calls are then ignored.
+        bool Write(const char* data, size_t len);
+
+        // Call after the last chunk.  False if the compressed stream was cut short.
+        bool Finish();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+
+    // ── Response arena ────────────────────────────────────────────────────────
+    // Body buffer that keeps its capacity between requests.  Owned by whoever
+    // issues the same request repeatedly (one per snapshot endpoint, one per
+    // metadata thread), so after the first poll a body is read into memory
+    // that is already there.  The view stays valid until the next request.
+    class ResponseArena
+    {
+    public:
+        ResponseArena() = default;
+        ResponseArena(const ResponseArena&)            = delete;
+        ResponseArena& operator=(const ResponseArena&) = delete;
+
+        void Clear() { m_Size = 0; }
+
+        // Ensure room for at least n more bytes; returns where they go.
+        char* Reserve(size_t n);
+        void  Commit(size_t n) { m_Size += n; }
+        void  Append(const char* data, size_t len);
+
+        std::string_view View() const { return { m_Data.get(), m_Size }; }
+        size_t           Capacity() const { return m_Capacity; }
+
+        BodyDecoder& Decoder() { return m_Decoder; }
+
+    private:
+        std::unique_ptr<char[]> m_Data;
+        size_t                  m_Size     = 0;
+        size_t                  m_Capacity = 0;
+        BodyDecoder             m_Decoder;
+    };
+
+    // Running totals across all transports.
+    struct TransferStats
+    {
+        uint64_t responses           = 0;
+        uint64_t compressedResponses = 0;
+        uint64_t wireBytes           = 0; // body bytes as received
+        uint64_t decodedBytes        = 0; // body bytes after decompression
+    };
+    TransferStats GetTransferStats();
+
+    // For a transport that reads an identity body straight into an arena,
+    // past the decoder: adds it to the totals the decoder would have.
+    void CountIdentityBytes(size_t len);
+
+    // ── Transport interface ───────────────────────────────────────────────────
+    // GW2Api talks to the network only through this, so the pooling and
+    // request logic can be driven by something other than WinHTTP.
+    // Implementations must be safe to call from several threads at once.
+    class ITransport
+    {
+    public:
+        virtual ~ITransport() = default;
+
+        // Blocking GET.  Returns false if no HTTP response was received at all
+        // (DNS, TLS or socket failure); any status code counts as a response.
+        virtual bool Get(const Request& req, Response& out) = 0;
+
+        // Drop pooled connections.  The transport stays usable and reconnects
+        // lazily on the next Get().
+        virtual void Close() = 0;
+    };
+
+    // Long-lived WinHTTP session bound to one host (Windows only).  The session keeps its
+    // sockets alive between requests, so only the first request after Close()
+    // (or after the server drops the connection) pays for a TLS handshake.
+    std::unique_ptr<ITransport> CreateWinHttpTransport(const std::wstring& host,
+                                                       int                 port,
+                                                       bool                secure);
+
+    // Plain HTTP/1.1 over TCP (no TLS), for a local mock server or a proxy in
+    // front of the API.  Builds on Windows (Winsock) and POSIX alike.
+    std::unique_ptr<ITransport> CreateSocketTransport(const std::string& host, int port);
+
+    // ── Record / replay ───────────────────────────────────────────────────────
+    // A recording transport forwards every request to inner and writes the
+    // response to dir, one file per request, numbered per path.  It always
+    // fetches the full body (validators are answered locally), so each
+    // capture can be replayed on its own, and keeps it as received, so replay
+    // inflates what the network would have sent.  The API key is never written.
+    std::unique_ptr<ITransport> CreateRecordingTransport(std::shared_ptr<ITransport> inner,
+                                                         const std::string&          dir);
+
+    // Serves captures from dir.  Each path replays its captures in order and
+    // then repeats the last one; a path with no capture answers 404.  An
+    // If-None-Match equal to the capture's ETag is answered with 304.  Every
+    // request is delayed by latencyMs to stand in for the network.
+    std::unique_ptr<ITransport> CreateReplayTransport(const std::string& dir, int latencyMs);
+
+    // ── Process-wide transport ────────────────────────────────────────────────
+    // On Windows, defaults to a WinHTTP transport for https://api.guildwars2.com.
+    // Elsewhere there is no default: null until SetTransport() is called.
+    std::shared_ptr<ITransport> GetTransport();
+    void SetTransport(std::shared_ptr<ITransport> transport);
+
+    // Close pooled connections.  Call on addon unload after all background
+    // threads have been joined.
+    void Shutdown();
+}
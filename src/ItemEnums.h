@@ -0,0 +1,119 @@
+#pragma once
+#include <string_view>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+
+// ── Item rarity / type ────────────────────────────────────────────────────────
+// /v2/items reports both as strings.  They are decoded once, when an item
+// enters the catalog, through perfect-hash tables built at compile time; from
+// then on colour lookup, grouping and sorting compare small integers.
+// Strings the tables don't know (a type added by a game update) decode to
+// Unknown; the catalog keeps the API's own string for those few items only
+// (Catalog::RarityName / TypeName), so they are still shown and saved.
+namespace ItemEnums
+{
+    // In tier order, so comparing values sorts by rarity.
+    enum class Rarity : uint8_t
+    {
+        Unknown = 0,
+        Junk, Basic, Fine, Masterwork, Rare, Exotic, Ascended, Legendary,
+        Count
+    };
+
+    // Alphabetical, matching the order the API strings sort in.
+    enum class ItemType : uint8_t
+    {
+        Unknown = 0,
+        Armor, Back, Bag, Consumable, Container, CraftingMaterial, Gathering, Gizmo,
+        JadeTechModule, Key, MiniPet, PowerCore, Relic, Tool, Trait, Trinket, Trophy,
+        UpgradeComponent, Weapon,
+        Count
+    };
+
+    // API spelling, indexed by enum value ("" for Unknown).
+    inline constexpr std::string_view RARITY_NAMES[] =
+    {
+        "", "Junk", "Basic", "Fine", "Masterwork", "Rare", "Exotic", "Ascended", "Legendary",
+    };
+    inline constexpr std::string_view TYPE_NAMES[] =
+    {
+        "", "Armor", "Back", "Bag", "Consumable", "Container", "CraftingMaterial", "Gathering",
+        "Gizmo", "JadeTechModule", "Key", "MiniPet", "PowerCore", "Relic", "Tool", "Trait",
+        "Trinket", "Trophy", "UpgradeComponent", "Weapon",
+    };
+    static_assert(std::size(RARITY_NAMES) == (size_t)Rarity::Count,   "RARITY_NAMES out of sync");
+    static_assert(std::size(TYPE_NAMES)   == (size_t)ItemType::Count, "TYPE_NAMES out of sync");
+
+    namespace detail
+    {
+        constexpr uint32_t Hash(std::string_view s, uint32_t seed)
+        {
+            uint32_t h = 2166136261u ^ seed; // FNV-1a
+            for (char c : s) { h ^= (uint8_t)c; h *= 16777619u; }
+            return h;
+        }
+
+        // slot[Hash(name, seed) & (SLOTS - 1)] holds the name's enum value;
+        // 0 marks an empty slot.
+        template <size_t SLOTS>
+        struct PerfectTable
+        {
+            uint32_t seed = ~0u; // ~0u = no collision-free seed found
+            uint8_t  slot[SLOTS] = {};
+        };
+
+        // Tries seeds until every name lands in its own slot.
+        template <size_t SLOTS, size_t N>
+        constexpr PerfectTable<SLOTS> Build(const std::string_view (&names)[N])
+        {
+            static_assert((SLOTS & (SLOTS - 1)) == 0 && SLOTS > N, "SLOTS: power of two > N");
+            for (uint32_t seed = 0; seed < 4096; ++seed)
+            {
+                PerfectTable<SLOTS> t;
+                t.seed = seed;
+                bool ok = true;
+                for (size_t i = 1; i < N && ok; ++i)
+                {
+                    size_t k = Hash(names[i], seed) & (SLOTS - 1);
+                    if (t.slot[k]) ok = false;
+                    else           t.slot[k] = (uint8_t)i;
+                }
+                if (ok) return t;
+            }
+            return {};
+        }
+
+        template <size_t SLOTS, size_t N>
+        constexpr uint8_t Lookup(const PerfectTable<SLOTS>& t,
+                                 const std::string_view (&names)[N], std::string_view s)
+        {
+            uint8_t i = t.slot[Hash(s, t.seed) & (SLOTS - 1)];
+            return (i && names[i] == s) ? i : 0;
+        }
+
+        inline constexpr auto RARITY_TABLE = Build<32>(RARITY_NAMES);
+        inline constexpr auto TYPE_TABLE   = Build<64>(TYPE_NAMES);
+        static_assert(RARITY_TABLE.seed != ~0u, "no perfect hash for rarities; grow the table");
+        static_assert(TYPE_TABLE.seed   != ~0u, "no perfect hash for item types; grow the table");
+    }
+
+    constexpr Rarity ParseRarity(std::string_view s)
+    {
+        return (Rarity)detail::Lookup(detail::RARITY_TABLE, RARITY_NAMES, s);
+    }
+
+    constexpr ItemType ParseType(std::string_view s)
+    {
+        return (ItemType)detail::Lookup(detail::TYPE_TABLE, TYPE_NAMES, s);
+    }
+
+    // Data is NUL-terminated (string literals).
+    constexpr std::string_view Name(Rarity r)   { return RARITY_NAMES[(size_t)r]; }
+    constexpr std::string_view Name(ItemType t) { return TYPE_NAMES[(size_t)t]; }
+
+    static_assert(ParseRarity("Exotic")           == Rarity::Exotic,             "");
+    static_assert(ParseRarity("Exotics")          == Rarity::Unknown,            "");
+    static_assert(ParseType("UpgradeComponent")   == ItemType::UpgradeComponent, "");
+    static_assert(ParseType("")                   == ItemType::Unknown,          "");
+}
@@ -0,0 +1,213 @@
+#include "ItemSearch.h"
+
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <cctype>
+#include <unordered_map>
+
+// ── Internal state ─────────────────────────────────────────────────────────────
+
+struct Doc
+{
+    const Catalog::Item* item;
+    std::string          lower; // lowercased name
+    std::string_view     type;  // Catalog::TypeName, so Unknown splits by spelling
+    bool                 live;  // false once a newer entry for the ID arrived
+};
+
+static std::vector<Doc>                                    s_Docs;
+static std::unordered_map<int, uint32_t>                   s_DocById;
+static std::unordered_map<uint32_t, std::vector<uint32_t>> s_Postings; // trigram -> docs, ascending
+static std::vector<uint32_t>                               s_Order;    // live docs by type, name
+static std::vector<uint32_t>                               s_Rank;     // doc -> position in s_Order
+static size_t                                              s_Cursor  = 0;
+static uint64_t                                            s_Version = 0;
+static size_t                                              s_DeadDocs = 0; // superseded, still posted
+
+// Last query and its result, kept so a growing query only narrows them.
+static std::string                       s_LastQuery;
+static uint64_t                          s_LastVersion = ~0ull;
+static std::vector<uint32_t>             s_LastDocs;   // in s_Order order
+static std::vector<const Catalog::Item*> s_Result;
+
+// ── Helpers ────────────────────────────────────────────────────────────────────
+
+static std::string Lower(std::string_view s)
+{
+    std::string out(s);
+    for (auto& ch : out) ch = (char)std::tolower((unsigned char)ch);
+    return out;
+}
+
+// Distinct trigrams of s, sorted.
+static std::vector<uint32_t> Trigrams(const std::string& s)
+{
+    std::vector<uint32_t> out;
+    if (s.size() < 3) return out;
+    out.reserve(s.size() - 2);
+    for (size_t i = 0; i + 3 <= s.size(); ++i)
+        out.push_back((uint32_t)(uint8_t)s[i] << 16 | (uint32_t)(uint8_t)s[i + 1] << 8
+                    | (uint8_t)s[i + 2]);
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+static bool OrderLess(uint32_t a, uint32_t b)
+{
+    const Catalog::Item* x = s_Docs[a].item;
+    const Catalog::Item* y = s_Docs[b].item;
+    if (x->type != y->type) return x->type < y->type;
+    if (s_Docs[a].type != s_Docs[b].type) return s_Docs[a].type < s_Docs[b].type;
+    if (x->name != y->name) return x->name < y->name;
+    return x->id < y->id;
+}
+
+// Docs containing every trigram of q, ascending by doc index.
+static std::vector<uint32_t> Candidates(const std::string& q)
+{
+    std::vector<const std::vector<uint32_t>*> lists;
+    for (uint32_t tri : Trigrams(q))
+    {
+        auto it = s_Postings.find(tri);
+        if (it == s_Postings.end()) return {};
+        lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(),
+        [](auto* a, auto* b) { return a->size() < b->size(); });
+
+    std::vector<uint32_t> cand = *lists[0], next;
+    for (size_t i = 1; i < lists.size() && !cand.empty(); ++i)
+    {
+        next.clear();
+        std::set_intersection(cand.begin(), cand.end(), lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(next));
+        cand.swap(next);
+    }
+    return cand;
+}
+
+// Drops superseded docs from the postings once they make up a quarter of the
+// docs, so a catalog refreshed by a game build doesn't keep every old name
+// indexed.  Doc indices stay as they are; a dead doc keeps only its pointer.
+static void PruneDeadDocs()
+{
+    if (s_DeadDocs * 4 < s_Docs.size()) return;
+
+    for (auto it = s_Postings.begin(); it != s_Postings.end();)
+    {
+        std::vector<uint32_t>& list = it->second;
+        list.erase(std::remove_if(list.begin(), list.end(),
+                       [](uint32_t d) { return !s_Docs[d].live; }),
+                   list.end());
+        if (list.empty()) it = s_Postings.erase(it);
+        else            { list.shrink_to_fit(); ++it; }
+    }
+    for (Doc& doc : s_Docs)
+        if (!doc.live) std::string().swap(doc.lower);
+    s_DeadDocs = 0;
+}
+
+// ── Public API ─────────────────────────────────────────────────────────────────
+
+void ItemSearch::Sync()
+{
+    std::vector<const Catalog::Item*> fresh;
+    s_Cursor = Catalog::CurrentItemsSince(s_Cursor, fresh);
+    if (fresh.empty()) return;
+
+    std::vector<uint32_t> added;
+    added.reserve(fresh.size());
+    for (const Catalog::Item* item : fresh)
+    {
+        uint32_t idx = (uint32_t)s_Docs.size();
+        auto [it, inserted] = s_DocById.try_emplace(item->id, idx);
+        if (!inserted)
+        {
+            // Superseded entry: drop it from the order; its postings are
+            // skipped by the live check until PruneDeadDocs() removes them.
+            s_Docs[it->second].live = false;
+            it->second = idx;
+            ++s_DeadDocs;
+        }
+
+        s_Docs.push_back({ item, Lower(item->name), Catalog::TypeName(*item), true });
+        for (uint32_t tri : Trigrams(s_Docs.back().lower))
+            s_Postings[tri].push_back(idx);
+        added.push_back(idx);
+    }
+
+    // Merge the new docs into the sorted order instead of re-sorting it.
+    s_Order.erase(std::remove_if(s_Order.begin(), s_Order.end(),
+                      [](uint32_t d) { return !s_Docs[d].live; }),
+                  s_Order.end());
+    added.erase(std::remove_if(added.begin(), added.end(),
+                    [](uint32_t d) { return !s_Docs[d].live; }),
+                added.end());
+    std::sort(added.begin(), added.end(), OrderLess);
+    size_t mid = s_Order.size();
+    s_Order.insert(s_Order.end(), added.begin(), added.end());
+    std::inplace_merge(s_Order.begin(), s_Order.begin() + mid, s_Order.end(), OrderLess);
+
+    s_Rank.resize(s_Docs.size());
+    for (size_t i = 0; i < s_Order.size(); ++i) s_Rank[s_Order[i]] = (uint32_t)i;
+
+    PruneDeadDocs();
+    ++s_Version;
+}
+
+const std::vector<const Catalog::Item*>& ItemSearch::Find(std::string_view query)
+{
+    std::string q = Lower(query);
+    const bool fresh = s_LastVersion == s_Version;
+    if (fresh && q == s_LastQuery) return s_Result;
+
+    std::vector<uint32_t> docs;
+    if (q.empty())
+        docs = s_Order;
+    else if (fresh && !s_LastQuery.empty() && q.find(s_LastQuery) != std::string::npos)
+    {
+        // Every match for q also matched the previous query.
+        for (uint32_t d : s_LastDocs)
+            if (s_Docs[d].lower.find(q) != std::string::npos) docs.push_back(d);
+    }
+    else if (q.size() >= 3)
+    {
+        // Trigrams only say the letters are there; confirm the substring.
+        for (uint32_t d : Candidates(q))
+            if (s_Docs[d].live && s_Docs[d].lower.find(q) != std::string::npos)
+                docs.push_back(d);
+        std::sort(docs.begin(), docs.end(),
+            [](uint32_t a, uint32_t b) { return s_Rank[a] < s_Rank[b]; });
+    }
+    else
+    {
+        for (uint32_t d : s_Order)
+            if (s_Docs[d].lower.find(q) != std::string::npos) docs.push_back(d);
+    }
+
+    s_LastQuery   = std::move(q);
+    s_LastVersion = s_Version;
+    s_LastDocs    = std::move(docs);
+
+    s_Result.clear();
+    s_Result.reserve(s_LastDocs.size());
+    for (uint32_t d : s_LastDocs) s_Result.push_back(s_Docs[d].item);
+    return s_Result;
+}
+
+uint64_t ItemSearch::GetVersion()
+{
+    return s_Version;
+}
+
+ItemSearch::Stats ItemSearch::GetStats()
+{
+    Stats st;
+    st.docs     = s_Docs.size();
+    st.liveDocs = s_Order.size();
+    st.trigrams = s_Postings.size();
+    for (auto& [tri, list] : s_Postings) st.postings += list.size();
+    return st;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Catalog.h"
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+// ── Item name search ──────────────────────────────────────────────────────────
+// Case-insensitive substring search over the catalog's current items, for the
+// profile editor.  Names are lowercased once and indexed by trigram when an
+// item enters the catalog; results come back already sorted by type (types
+// the enum doesn't know by their spelling), then name.  A query that extends the previous one only narrows the last result.
+//
+// Render thread only: nothing here is locked.
+namespace ItemSearch
+{
+    // Indexes items that became current since the last call.  Cheap when the
+    // catalog hasn't changed; call once per frame before Find().
+    void Sync();
+
+    // Current items whose name contains query.  The reference stays valid
+    // until the next Sync() or Find().
+    const std::vector<const Catalog::Item*>& Find(std::string_view query);
+
+    // Increases whenever Sync() indexed something.
+    uint64_t GetVersion();
+
+    struct Stats
+    {
+        size_t docs     = 0; // every entry indexed, superseded ones included
+        size_t liveDocs = 0; // current entries
+        size_t trigrams = 0; // distinct trigrams with postings
+        size_t postings = 0; // doc references across all of them
+    };
+    Stats GetStats();
+}
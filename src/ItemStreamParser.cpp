@@ -0,0 +1,315 @@
+#include "ItemStreamParser.h"
+
+#include <cstring>
+#include <climits>
+
+// Deeper nesting than this never occurs in inventory responses.
+static const size_t MAX_DEPTH = 32;
+
+ItemStreamParser::ItemStreamParser(Layout layout, int slotMarker,
+                                   std::vector<GW2Api::ItemStack>& out)
+    : m_Layout(layout), m_SlotMarker(slotMarker), m_Out(out)
+{
+    m_Stack.reserve(MAX_DEPTH);
+}
+
+void ItemStreamParser::Reset()
+{
+    m_Stack.clear();
+    m_Done      = false;
+    m_Error     = false;
+    m_Lex       = Lex::Idle;
+    m_StrIsKey  = false;
+    m_Escape    = false;
+    m_KeyLen    = 0;
+    m_NumNeg    = false;
+    m_NumIsInt  = true;
+    m_NumDigits = 0;
+    m_NumVal    = 0;
+    m_Literal   = nullptr;
+    m_LitPos    = 0;
+    m_ItemId    = 0;
+    m_ItemCount = 0;
+    m_HasId     = false;
+    m_HasCount  = false;
+    m_ItemSlot  = 0;
+    m_Slot      = 0;
+}
+
+bool ItemStreamParser::Fail()
+{
+    m_Error = true;
+    return false;
+}
+
+// True when the grammar allows a value to start here.
+bool ItemStreamParser::ValueAllowed() const
+{
+    if (m_Stack.empty()) return !m_Done;
+    const Frame& top = m_Stack.back();
+    return top.expect == Expect::Value || top.expect == Expect::ValueOrEnd;
+}
+
+// Role of the value about to start, from its parent container and key.
+ItemStreamParser::Role ItemStreamParser::ChildRole() const
+{
+    if (m_Stack.empty())
+        return m_Layout == Layout::AccountSlots ? Role::ItemList : Role::Root;
+
+    const Frame& top = m_Stack.back();
+    switch (top.role)
+    {
+    case Role::Root:     return top.key == Key::Bags      ? Role::BagList  : Role::Other;
+    case Role::BagList:  return Role::Bag;
+    case Role::Bag:      return top.key == Key::Inventory ? Role::ItemList : Role::Other;
+    case Role::ItemList: return Role::Item;
+    default:             return Role::Other;
+    }
+}
+
+void ItemStreamParser::ValueEnd()
+{
+    if (m_Stack.empty()) m_Done = true;
+    else                 m_Stack.back().expect = Expect::CommaOrEnd;
+}
+
+bool ItemStreamParser::OpenContainer(bool isObject)
+{
+    if (!ValueAllowed() || m_Stack.size() >= MAX_DEPTH) return Fail();
+
+    Role role = ChildRole();
+    bool wantObject = (role == Role::Root || role == Role::Bag || role == Role::Item);
+    if (role != Role::Other && isObject != wantObject)
+    {
+        // The document root must have the expected shape; anywhere else an
+        // unexpected container is just skipped.
+        if (m_Stack.empty()) return Fail();
+        role = Role::Other;
+    }
+
+    if (role == Role::Item)
+    {
+        m_ItemId    = 0;
+        m_ItemCount = 0;
+        m_HasId     = false;
+        m_HasCount  = false;
+        m_ItemSlot  = m_Slot++;
+    }
+
+    m_Stack.push_back({ role, isObject,
+                        isObject ? Expect::KeyOrEnd : Expect::ValueOrEnd,
+                        Key::None });
+    return true;
+}
+
+bool ItemStreamParser::CloseContainer(bool isObject)
+{
+    if (m_Stack.empty()) return Fail();
+    const Frame& top = m_Stack.back();
+    if (top.isObject != isObject) return Fail();
+    if (isObject  && top.expect != Expect::KeyOrEnd   && top.expect != Expect::CommaOrEnd) return Fail();
+    if (!isObject && top.expect != Expect::ValueOrEnd && top.expect != Expect::CommaOrEnd) return Fail();
+
+    Role role = top.role;
+    m_Stack.pop_back();
+    if (role == Role::Item && !EmitItem()) return false;
+    ValueEnd();
+    return true;
+}
+
+bool ItemStreamParser::OnNull()
+{
+    if (m_Stack.empty()) return Fail();
+
+    // Empty bag / empty bag slot: still occupies a slot index.
+    Role role = ChildRole();
+    if (role == Role::Bag || role == Role::Item)
+        ++m_Slot;
+    ValueEnd();
+    return true;
+}
+
+bool ItemStreamParser::OnNumber()
+{
+    if (m_Stack.empty()) return Fail();
+
+    const Frame& top = m_Stack.back();
+    if (top.role == Role::Item && (top.key == Key::Id || top.key == Key::Count))
+    {
+        if (!m_NumIsInt || m_NumDigits == 0) return Fail();
+        int64_t v = m_NumNeg ? -m_NumVal : m_NumVal;
+        if (v < INT_MIN || v > INT_MAX) return Fail();
+        if (top.key == Key::Id) { m_ItemId    = (int)v; m_HasId    = true; }
+        else                    { m_ItemCount = (int)v; m_HasCount = true; }
+    }
+    ValueEnd();
+    return true;
+}
+
+void ItemStreamParser::OnKey()
+{
+    Frame& top = m_Stack.back();
+    top.expect = Expect::Colon;
+    top.key    = Key::Other;
+    if (m_KeyLen > sizeof(m_KeyBuf)) return; // too long for any key we match
+
+    auto is = [this](const char* k)
+        { return m_KeyLen == strlen(k) && memcmp(m_KeyBuf, k, m_KeyLen) == 0; };
+
+    if      (is("id"))        top.key = Key::Id;
+    else if (is("count"))     top.key = Key::Count;
+    else if (is("bags"))      top.key = Key::Bags;
+    else if (is("inventory")) top.key = Key::Inventory;
+}
+
+bool ItemStreamParser::EmitItem()
+{
+    if (!m_HasId) return Fail();
+
+    if (m_Layout == Layout::CharacterBags)
+    {
+        if (!m_HasCount) return Fail();
+        m_Out.push_back({ m_ItemId, m_ItemCount, m_ItemSlot });
+    }
+    else if (m_HasCount && m_ItemCount > 0)
+    {
+        m_Out.push_back({ m_ItemId, m_ItemCount, m_SlotMarker });
+    }
+    return true;
+}
+
+bool ItemStreamParser::Feed(const char* data, size_t len)
+{
+    if (m_Error) return false;
+
+    size_t i = 0;
+    while (i < len)
+    {
+        char c = data[i];
+
+        switch (m_Lex)
+        {
+        case Lex::String:
+            ++i;
+            if (m_Escape)
+            {
+                // Escaped characters never occur in the keys we match.
+                m_Escape = false;
+                if (m_StrIsKey) m_KeyLen = sizeof(m_KeyBuf) + 1;
+            }
+            else if (c == '\\')
+                m_Escape = true;
+            else if (c == '"')
+            {
+                m_Lex = Lex::Idle;
+                if (m_StrIsKey) OnKey();
+                else            ValueEnd();
+            }
+            else if (m_StrIsKey)
+            {
+                if (m_KeyLen < sizeof(m_KeyBuf)) m_KeyBuf[m_KeyLen] = c;
+                if (m_KeyLen <= sizeof(m_KeyBuf)) ++m_KeyLen;
+            }
+            continue;
+
+        case Lex::Number:
+            if (c >= '0' && c <= '9')
+            {
+                if (m_NumDigits < 18) m_NumVal = m_NumVal * 10 + (c - '0');
+                else                  m_NumIsInt = false; // too large for an ID
+                ++m_NumDigits;
+                ++i;
+                continue;
+            }
+            if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')
+            {
+                m_NumIsInt = false;
+                ++i;
+                continue;
+            }
+            // Number ended; c is handled below as a normal token.
+            m_Lex = Lex::Idle;
+            if (!OnNumber()) return false;
+            continue;
+
+        case Lex::Literal:
+            ++i;
+            if (c != m_Literal[m_LitPos]) return Fail();
+            if (m_Literal[++m_LitPos] == '\0')
+            {
+                m_Lex = Lex::Idle;
+                if (m_Literal[0] == 'n') { if (!OnNull()) return false; }
+                else if (m_Stack.empty()) return Fail();
+                else ValueEnd();
+            }
+            continue;
+
+        case Lex::Idle:
+            break;
+        }
+
+        ++i;
+        switch (c)
+        {
+        case ' ': case '\t': case '\r': case '\n':
+            break;
+
+        case '{': if (!OpenContainer(true))   return false; break;
+        case '[': if (!OpenContainer(false))  return false; break;
+        case '}': if (!CloseContainer(true))  return false; break;
+        case ']': if (!CloseContainer(false)) return false; break;
+
+        case ':':
+            if (m_Stack.empty() || m_Stack.back().expect != Expect::Colon) return Fail();
+            m_Stack.back().expect = Expect::Value;
+            break;
+
+        case ',':
+            if (m_Stack.empty() || m_Stack.back().expect != Expect::CommaOrEnd) return Fail();
+            m_Stack.back().expect = m_Stack.back().isObject ? Expect::Key : Expect::Value;
+            break;
+
+        case '"':
+            m_StrIsKey = !m_Stack.empty() && m_Stack.back().isObject &&
+                         (m_Stack.back().expect == Expect::KeyOrEnd ||
+                          m_Stack.back().expect == Expect::Key);
+            if (!m_StrIsKey && (!ValueAllowed() || m_Stack.empty())) return Fail();
+            m_Escape = false;
+            m_KeyLen = 0;
+            m_Lex    = Lex::String;
+            break;
+
+        case 'n': case 't': case 'f':
+            if (!ValueAllowed()) return Fail();
+            m_Literal = (c == 'n') ? "null" : (c == 't') ? "true" : "false";
+            m_LitPos  = 1;
+            m_Lex     = Lex::Literal;
+            break;
+
+        default:
+            if (c == '-' || (c >= '0' && c <= '9'))
+            {
+                if (!ValueAllowed()) return Fail();
+                m_NumNeg    = (c == '-');
+                m_NumVal    = m_NumNeg ? 0 : (c - '0');
+                m_NumDigits = m_NumNeg ? 0 : 1;
+                m_NumIsInt  = true;
+                m_Lex       = Lex::Number;
+                break;
+            }
+            return Fail();
+        }
+    }
+    return true;
+}
+
+bool ItemStreamParser::Finish()
+{
+    if (m_Error) return false;
+    if (m_Lex == Lex::Number)
+    {
+        m_Lex = Lex::Idle;
+        if (!OnNumber()) return false;
+    }
+    return m_Done && m_Lex == Lex::Idle;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include "GW2Api.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// ── Streaming parser for the inventory endpoints ──────────────────────────────
+// Consumes a response body in arbitrary chunks as they arrive from the network
+// and appends every item stack straight to an output vector — no JSON DOM is
+// built.  Two response shapes are understood:
+//
+//   AccountSlots   /v2/account/bank, /v2/account/materials, /v2/account/inventory
+//                  [ { "id": 19721, "count": 250, ... }, null, ... ]
+//
+//   CharacterBags  /v2/characters/<name>/inventory
+//                  { "bags": [ { "inventory": [ { "id": .., "count": .. }, null ] }, null ] }
+//
+// Unknown keys and nested values (upgrades, infusions, stats, ...) are skipped.
+class ItemStreamParser
+{
+public:
+    enum class Layout { AccountSlots, CharacterBags };
+
+    // AccountSlots stacks are tagged with slotMarker and dropped when their
+    // count is missing or <= 0.  CharacterBags stacks get their running bag
+    // slot index (empty slots and missing bags still advance it).
+    ItemStreamParser(Layout layout, int slotMarker, std::vector<GW2Api::ItemStack>& out);
+
+    // Start over on a new document, keeping the stack's capacity.  Stacks
+    // already appended to out stay there.
+    void Reset();
+
+    // Consume the next chunk.  Returns false once the input is malformed;
+    // later calls are then ignored.
+    bool Feed(const char* data, size_t len);
+
+    // Call after the last chunk.  True if one complete document was consumed.
+    bool Finish();
+
+private:
+    // What a container means for item extraction.
+    enum class Role   : uint8_t { Other, Root, BagList, Bag, ItemList, Item };
+    enum class Key    : uint8_t { None, Other, Id, Count, Bags, Inventory };
+    enum class Expect : uint8_t { KeyOrEnd, Key, Colon, Value, ValueOrEnd, CommaOrEnd };
+    enum class Lex    : uint8_t { Idle, String, Number, Literal };
+
+    struct Frame
+    {
+        Role   role;
+        bool   isObject;
+        Expect expect;
+        Key    key;     // objects: key of the value currently being read
+    };
+
+    bool Fail();
+    bool ValueAllowed() const;
+    Role ChildRole() const;
+    void ValueEnd();
+
+    bool OpenContainer(bool isObject);
+    bool CloseContainer(bool isObject);
+    bool OnNull();
+    bool OnNumber();
+    void OnKey();
+    bool EmitItem();
+
+    Layout                          m_Layout;
+    int                             m_SlotMarker;
+    std::vector<GW2Api::ItemStack>& m_Out;
+
+    std::vector<Frame> m_Stack;
+    bool m_Done  = false; // root value complete
+    bool m_Error = false;
+
+    // Lexer state — survives chunk boundaries.
+    Lex     m_Lex = Lex::Idle;
+    bool    m_StrIsKey = false;
+    bool    m_Escape   = false;
+    char    m_KeyBuf[16];
+    size_t  m_KeyLen   = 0;
+    bool    m_NumNeg   = false;
+    bool    m_NumIsInt = true;
+    int     m_NumDigits = 0;
+    int64_t m_NumVal   = 0;
+    const char* m_Literal = nullptr; // "null" / "true" / "false"
+    size_t  m_LitPos   = 0;
+
+    // Item currently being read.
+    int  m_ItemId    = 0;
+    int  m_ItemCount = 0;
+    bool m_HasId     = false;
+    bool m_HasCount  = false;
+    int  m_ItemSlot  = 0;
+    int  m_Slot      = 0; // running CharacterBags slot index
+};
@@ -0,0 +1,36 @@
+#include "Log.h"
+
+#ifdef _WIN32
+
+#include "Shared.h"
+
+bool Log::Enabled()
+{
+    return APIDefs != nullptr;
+}
+
+void Log::Write(Level level, const char* message)
+{
+    if (!APIDefs) return;
+    ELogLevel l = level == Level::Warning ? LOGL_WARNING
+                : level == Level::Info    ? LOGL_INFO
+                :                           LOGL_DEBUG;
+    APIDefs->Log(l, "LootTracker", message);
+}
+
+#else
+
+#include <cstdio>
+
+bool Log::Enabled()
+{
+    return true;
+}
+
+void Log::Write(Level level, const char* message)
+{
+    static const char* const NAMES[] = { "debug", "info", "warning" };
+    fprintf(stderr, "[LootTracker %s] %s\n", NAMES[(int)level], message);
+}
+
+#endif
@@ -0,0 +1,15 @@
+#pragma once
+
+// ── Log output for the portable core ─────────────────────────────────────────
+// Code that also builds off Windows (GW2Api) logs through here instead of
+// APIDefs->Log.  In the addon messages go to the Nexus log once APIDefs is
+// set; in the portable build they go to stderr.
+namespace Log
+{
+    enum class Level { Debug, Info, Warning };
+
+    // False while there is nowhere to log to; check it before formatting.
+    bool Enabled();
+
+    void Write(Level level, const char* message);
+}
@@ -4,13 +4,17 @@
 #include "Shared.h"
 #include "SessionHistory.h"
 #include "TrackingFilter.h"
+#include "MetadataCache.h"
+#include "SnapshotDiff.h"
 
-#include <unordered_map>
+#include <psapi.h>
 #include <unordered_set>
 #include <mutex>
 #include <chrono>
 #include <ctime>
 #include <thread>
+#include <atomic>
+#include <condition_variable>
 #include <algorithm>
 
 using Clock   = std::chrono::steady_clock;
@@ -21,6 +25,8 @@ using Seconds = std::chrono::seconds;
 static std::mutex s_Mutex;
 static std::atomic<bool> s_Stopping{false}; // set in Shutdown() before joining threads
 static std::thread s_InitThread;
+static std::thread s_ResolverThread;
+static std::condition_variable s_ResolverCv; // paired with s_Mutex
 
 static bool  s_Active    = false;
 static bool  s_HasBase   = false; // true once the first snapshot has been received
@@ -33,92 +39,439 @@ static uint32_t s_LastMapId    = 0;
 static int      s_LastAutoHour = -1;
 static int      s_LastAutoDay  = -1;
 
-// Baseline snapshots (taken on session start).
-static std::unordered_map<int, int64_t> s_BaseWallet;  // currency id -> value
-static std::unordered_map<int, int>     s_BaseItems;   // item id     -> count
+// ── Normalised snapshots (see SnapshotDiff) ──────────────────────────────────
+// The baseline wallet (taken on session start), and the buffers the latest
+// snapshot is normalised into.  The baseline item counts live in the delta
+// rows.
+static SnapshotDiff::WalletColumns s_BaseWallet, s_NewWallet;
+static SnapshotDiff::ItemColumns   s_NewItems;
+static bool                        s_OverflowLogged = false; // currency ID past the dense range
 
 // Set to true by Start() so the very next snapshot is recorded as the new
 // baseline rather than diffed against the old one.
 static bool s_NeedsNewBase = false;
 
-// Accumulated deltas since the session started.
-static std::unordered_map<int, int64_t> s_DeltaWallet;
-static std::unordered_map<int, int>     s_DeltaItems;
+// Accumulated deltas since the session started, and scratch for the IDs a
+// diff shows for the first time.
+static SnapshotDiff::ItemDeltas     s_DeltaItems;
+static SnapshotDiff::CurrencyDeltas s_DeltaWallet;
+static std::vector<int>             s_NewlyShown;
 
-// Resolved info cache (filled asynchronously from FetchItemDetails).
-static std::unordered_map<int, GW2Api::ItemInfo>     s_ItemInfo;
-static std::unordered_map<int, GW2Api::CurrencyInfo> s_CurrencyInfo;
+// What the UI reads — see PublishDeltaView().  Accessed only through
+// std::atomic_load/atomic_store.
+static std::shared_ptr<const LootSession::DeltaView> s_View =
+    std::make_shared<const LootSession::DeltaView>();
+static uint64_t s_ViewVersion = 0;
 
-// IDs waiting for their info to be fetched.
+// IDs waiting for their info to be fetched.  Only QueueItem/QueueCurrency
+// add to these.
 static std::unordered_set<int> s_PendingItemIds;
 static std::unordered_set<int> s_PendingCurrencyIds;
 
+// IDs the resolver thread is fetching right now; never queued twice.  If
+// their batch fails they go back to the pending sets, so a request made
+// while they were in flight is not lost.
+static std::unordered_set<int> s_InFlightItemIds;
+static std::unordered_set<int> s_InFlightCurrencyIds;
+static Clock::time_point       s_LastQueuedAt;
+static Clock::time_point       s_RetryAt;      // no fetch before this after a failed round
+static Clock::duration         s_RetryDelay{}; // doubles with each failed round in a row
+
+// Icons are registered with Nexus once per ID, the first time the ID is
+// needed — loading metadata.bin must not start thousands of downloads.
+static std::unordered_set<int> s_ItemIconsRequested;
+static std::unordered_set<int> s_CurrencyIconsRequested;
+
+// Game build the catalog's resolved entries belong to (0 = not known yet),
+// metadata.bin header flags, and whether the catalog has entries the file
+// doesn't.
+static uint32_t s_MetadataBuild = 0;
+static uint32_t s_MetadataFlags = 0;
+static bool     s_MetadataDirty = false;
+
+// After a game update: the build being refreshed to (0 = none), and the IDs
+// whose refreshed info hasn't landed yet.  s_MetadataBuild (and so the build
+// written to metadata.bin) moves on only once both sets are empty.
+static uint32_t                s_RefreshBuild = 0;
+static std::unordered_set<int> s_RefreshItemIds;
+static std::unordered_set<int> s_RefreshCurrencyIds;
+
 // ── Info resolution helpers ───────────────────────────────────────────────────
 
-// Fetches item/currency info for any IDs we haven't resolved yet.
-// Called from the snapshot thread — no ImGui interaction here.
-static void ResolveNewIds()
+// Registers an icon texture with Nexus (async; no callback needed here).
+// icon URLs look like: https://render.guildwars2.com/file/<hash>/<id>.png
+// texId is a catalog string, so it is NUL-terminated.
+static void LoadIconTexture(std::string_view texId, std::string_view iconUrl)
+{
+    if (!APIDefs || iconUrl.empty() || s_Stopping) return;
+
+    // Split URL into host + path for LoadTextureFromURL
+    const std::string_view host = "https://render.guildwars2.com";
+    std::string path(iconUrl);
+    // Strip the host prefix if present
+    if (iconUrl.substr(0, host.size()) == host)
+        path = std::string(iconUrl.substr(host.size()));
+
+    APIDefs->Textures_LoadFromURL(texId.data(),
+        "https://render.guildwars2.com",
+        path.c_str(),
+        nullptr); // no callback — UI polls Textures_Get each frame
+}
+
+// Queues an ID for the resolver thread unless it is already pending or being
+// fetched.  Caller holds s_Mutex.
+static void QueueItem(int id)
+{
+    if (s_InFlightItemIds.count(id) || !s_PendingItemIds.insert(id).second) return;
+    s_LastQueuedAt = Clock::now();
+    s_ResolverCv.notify_one();
+}
+
+static void QueueCurrency(int id)
+{
+    if (s_InFlightCurrencyIds.count(id) || !s_PendingCurrencyIds.insert(id).second) return;
+    s_LastQueuedAt = Clock::now();
+    s_ResolverCv.notify_one();
+}
+
+// Rebuilds the delta view from s_DeltaItems/s_DeltaWallet, pointing each row
+// at its current catalog entry, then swaps it in.  Sort order is worked out
+// here, once per change, rather than by the UI every frame.  Caller holds
+// s_Mutex.
+static void PublishDeltaView()
+{
+    auto view = std::make_shared<LootSession::DeltaView>();
+    view->version = ++s_ViewVersion;
+
+    const SnapshotDiff::ItemDeltas& d = s_DeltaItems;
+    for (size_t i = 0; i < d.ids.size(); ++i)
+        if (d.shown[i])
+            view->items.push_back({ d.ids[i], d.delta[i], Catalog::ItemFor(d.ids[i]) });
+
+    const SnapshotDiff::CurrencyDeltas& w = s_DeltaWallet;
+    for (size_t i = 0; i < w.ids.size(); ++i)
+        if (w.delta[i] != 0)
+            view->currencies.push_back({ w.ids[i], w.delta[i], Catalog::CurrencyFor(w.ids[i]) });
+
+    // Sort: gained first (descending delta), then losses
+    std::sort(view->items.begin(), view->items.end(),
+        [](const LootSession::ItemDelta& a, const LootSession::ItemDelta& b)
+        { return a.delta > b.delta; });
+    std::sort(view->currencies.begin(), view->currencies.end(),
+        [](const LootSession::CurrencyDelta& a, const LootSession::CurrencyDelta& b)
+        { return a.delta > b.delta; });
+
+    std::atomic_store(&s_View, std::shared_ptr<const LootSession::DeltaView>(std::move(view)));
+}
+
+// Publishes one batch of resolved item info.  Called as each batch arrives,
+// so names and icons fill in progressively while later batches are in flight.
+static void PublishItemInfos(const std::vector<GW2Api::ItemInfo>& infos)
 {
-    std::vector<int> needItems, needCurrencies;
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    for (auto& i : infos)
+    {
+        const Catalog::Item* e = Catalog::UpdateItem(i);
+        s_InFlightItemIds.erase(i.id);
+        s_RefreshItemIds.erase(i.id);
+        s_ItemIconsRequested.insert(i.id);
+        LoadIconTexture(e->textureId, e->iconUrl);
+    }
+    s_MetadataDirty = true;
+    MetadataCache::NoteFetched(infos.size(), 0);
+    PublishDeltaView();
+}
+
+static void PublishCurrencyInfos(const std::vector<GW2Api::CurrencyInfo>& infos)
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    for (auto& c : infos)
+    {
+        const Catalog::Currency* e = Catalog::UpdateCurrency(c);
+        s_InFlightCurrencyIds.erase(c.id);
+        s_RefreshCurrencyIds.erase(c.id);
+        s_CurrencyIconsRequested.insert(c.id);
+        LoadIconTexture(e->textureId, e->iconUrl);
+    }
+    s_MetadataDirty = true;
+    MetadataCache::NoteFetched(0, infos.size());
+    PublishDeltaView();
+}
+
+// Registers the icon of an ID that is about to be shown.  An ID the catalog
+// doesn't know, or only knows from session history (no icon URL), is queued
+// for a full lookup; its icon loads on publish.  Caller holds s_Mutex.
+static void EnsureItemIcon(int id)
+{
+    if (s_ItemIconsRequested.count(id)) return;
+    const Catalog::Item* e = Catalog::FindItem(id);
+    if (!e || e->iconUrl.empty()) { QueueItem(id); return; }
+    s_ItemIconsRequested.insert(id);
+    LoadIconTexture(e->textureId, e->iconUrl);
+}
+
+static void EnsureCurrencyIcon(int id)
+{
+    if (s_CurrencyIconsRequested.count(id)) return;
+    const Catalog::Currency* e = Catalog::FindCurrency(id);
+    if (!e || e->iconUrl.empty()) { QueueCurrency(id); return; }
+    s_CurrencyIconsRequested.insert(id);
+    LoadIconTexture(e->textureId, e->iconUrl);
+}
+
+// Writes metadata.bin if anything was resolved since the last write.  The
+// catalog is the only copy of the info; the file is written straight from it.
+static void SaveMetadataIfDirty()
+{
+    uint32_t build, flags;
     {
         std::lock_guard<std::mutex> lock(s_Mutex);
-        needItems      = std::vector<int>(s_PendingItemIds.begin(),     s_PendingItemIds.end());
-        needCurrencies = std::vector<int>(s_PendingCurrencyIds.begin(), s_PendingCurrencyIds.end());
+        if (!s_MetadataDirty) return;
+        s_MetadataDirty = false;
+        build           = s_MetadataBuild;
+        flags           = s_MetadataFlags;
     }
+    MetadataCache::Save(build, flags, Catalog::KnownItems(), Catalog::KnownCurrencies());
+}
+
+// ── Memory report ─────────────────────────────────────────────────────────────
+// Logged once startup has settled and again at unload.  The process figures
+// are the whole game's (the addon lives in its address space); the addon's
+// own share is broken down after them.
+
+template <typename C>
+static size_t HashBytes(const C& c)
+{
+    return c.size() * (sizeof(typename C::value_type) + 2 * sizeof(void*))
+         + c.bucket_count() * sizeof(void*);
+}
+
+static void LogMemoryReport(const char* when)
+{
+    if (!APIDefs) return;
+
+    PROCESS_MEMORY_COUNTERS_EX pmc{};
+    pmc.cb = sizeof(pmc);
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc)))
+        pmc = PROCESS_MEMORY_COUNTERS_EX{};
 
-    if (!needItems.empty())
+    const Catalog::Stats              cat  = Catalog::GetStats();
+    const SessionHistory::MemoryStats hist = SessionHistory::GetMemoryStats();
+
+    size_t sessionBytes = 0, viewBytes = 0;
     {
-        auto infos = GW2Api::FetchItemDetails(needItems);
         std::lock_guard<std::mutex> lock(s_Mutex);
-        for (auto& i : infos)
-        {
-            s_ItemInfo[i.id] = i;
-            s_PendingItemIds.erase(i.id);
+        const SnapshotDiff::ItemDeltas& d = s_DeltaItems;
+        for (const SnapshotDiff::ItemColumns* c : { &s_NewItems, &s_DeltaItems.added })
+            sessionBytes += (c->ids.capacity() + c->counts.capacity()) * sizeof(int);
+        for (const SnapshotDiff::WalletColumns* w : { &s_BaseWallet, &s_NewWallet })
+            sessionBytes += w->values.capacity() * sizeof(int64_t) + w->ids.capacity() * sizeof(int)
+                          + w->overflow.capacity() * sizeof(w->overflow[0]);
+        sessionBytes += (d.ids.capacity() + d.base.capacity() + d.delta.capacity()) * sizeof(int)
+                      + d.shown.capacity()
+                      + s_DeltaWallet.ids.capacity() * sizeof(int)
+                      + s_DeltaWallet.delta.capacity() * sizeof(int64_t)
+                      + s_NewlyShown.capacity() * sizeof(int)
+                      + HashBytes(s_PendingItemIds) + HashBytes(s_PendingCurrencyIds)
+                      + HashBytes(s_InFlightItemIds) + HashBytes(s_InFlightCurrencyIds)
+                      + HashBytes(s_ItemIconsRequested) + HashBytes(s_CurrencyIconsRequested)
+                      + HashBytes(s_RefreshItemIds) + HashBytes(s_RefreshCurrencyIds);
+    }
+    auto view = std::atomic_load(&s_View);
+    viewBytes = sizeof(*view) + view->items.capacity() * sizeof(LootSession::ItemDelta)
+              + view->currencies.capacity() * sizeof(LootSession::CurrencyDelta);
+
+    const size_t catalogBytes = cat.arenaBytes + cat.entryBytes;
+    const size_t addonBytes   = catalogBytes + hist.bodyBytes + sessionBytes + viewBytes;
+
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+        "Memory %s: process %zu KB private, %zu KB working set. Addon ~%zu KB: "
+        "catalog %zu KB (%zu items + %zu currencies, %zu strings in %zu KB arena); "
+        "history %zu KB (%zu of %zu sessions decoded; %zu segments, %zu KB mapped, shared); "
+        "session state %zu KB; delta view %zu KB.",
+        when, (size_t)pmc.PrivateUsage / 1024, (size_t)pmc.WorkingSetSize / 1024,
+        addonBytes / 1024, catalogBytes / 1024, cat.items, cat.currencies, cat.strings,
+        cat.arenaBytes / 1024, hist.bodyBytes / 1024, hist.bodies, hist.sessions,
+        hist.segments, hist.mappedBytes / 1024, sessionBytes / 1024, viewBytes / 1024);
+    APIDefs->Log(LOGL_INFO, "LootTracker", buf);
+}
 
-            // Register icon texture with Nexus (async; no callback needed here)
-            if (APIDefs && !i.iconUrl.empty())
-            {
-                std::string texId = "LT_ITEM_" + std::to_string(i.id);
-                // Split URL into host + path for LoadTextureFromURL
-                // icon URLs look like:
-                // https://render.guildwars2.com/file/<hash>/<id>.png
-                const std::string host = "https://render.guildwars2.com";
-                std::string path = i.iconUrl;
-                // Strip the host prefix if present
-                if (path.rfind(host, 0) == 0)
-                    path = path.substr(host.size());
-
-                APIDefs->Textures_LoadFromURL(texId.c_str(),
-                    "https://render.guildwars2.com",
-                    path.c_str(),
-                    nullptr); // no callback — UI polls Textures_Get each frame
-            }
-        }
+// Stamps the refresh build once every ID in it has landed.  Caller holds
+// s_Mutex.
+static void FinishRefreshIfDone()
+{
+    if (s_RefreshBuild == 0 || !s_RefreshItemIds.empty() || !s_RefreshCurrencyIds.empty())
+        return;
+    s_MetadataBuild = s_RefreshBuild;
+    s_RefreshBuild  = 0;
+    s_MetadataDirty = true;
+    if (APIDefs)
+        APIDefs->Log(LOGL_INFO, "LootTracker", "Cached item and currency info refreshed.");
+}
+
+// A game update can change item names, icons and vendor values.  Once Mumble
+// reports a build other than the one the cache was written under, every ID
+// resolved under the old build is queued for a refresh.  Until the refresh
+// has landed metadata.bin keeps the old build, so a restart half-way through
+// starts cold instead of trusting half-refreshed data.  Caller holds s_Mutex.
+static void CheckMetadataBuild()
+{
+    uint32_t build = MumbleLink ? MumbleLink->Context.BuildId : 0;
+    if (build == 0 || build == s_MetadataBuild || build == s_RefreshBuild) return;
+
+    if (s_MetadataBuild == 0)
+    {
+        // Nothing was loaded from an older build; what resolves now is current.
+        s_MetadataBuild = build;
+        s_MetadataDirty = true;
+        return;
     }
 
-    if (!needCurrencies.empty())
+    // An update can add currencies the refresh doesn't know to ask for; the
+    // next start fetches the full list again.
+    s_MetadataFlags &= ~MetadataCache::FLAG_ALL_CURRENCIES;
+    s_RefreshBuild   = build;
+    s_RefreshItemIds.clear();
+    s_RefreshCurrencyIds.clear();
+    // Entries without an icon URL are only known from history; they were
+    // never resolved, so there is nothing of theirs to refresh.
+    for (const Catalog::Item* item : Catalog::KnownItems())
+        if (!item->iconUrl.empty() && s_RefreshItemIds.insert(item->id).second)
+            QueueItem(item->id);
+    for (const Catalog::Currency* c : Catalog::KnownCurrencies())
+        if (!c->iconUrl.empty() && s_RefreshCurrencyIds.insert(c->id).second)
+            QueueCurrency(c->id);
+    if (APIDefs)
     {
-        auto infos = GW2Api::FetchCurrencyDetails(needCurrencies);
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        for (auto& c : infos)
+        char buf[160];
+        snprintf(buf, sizeof(buf),
+                 "Game build changed (%u -> %u) — refreshing %zu items + %zu currencies.",
+                 s_MetadataBuild, build, s_RefreshItemIds.size(), s_RefreshCurrencyIds.size());
+        APIDefs->Log(LOGL_INFO, "LootTracker", buf);
+    }
+    FinishRefreshIfDone();
+}
+
+// Marks the IDs of a finished resolver round as refreshed: those that landed
+// and those the API no longer knows.  IDs whose batch failed stay in the set
+// and are retried.  Caller holds s_Mutex.
+static void NoteRefreshed(const std::vector<int>& requested, const std::vector<int>& failed,
+                          std::unordered_set<int>& refresh)
+{
+    if (refresh.empty()) return;
+    std::unordered_set<int> failedSet(failed.begin(), failed.end());
+    for (int id : requested)
+        if (!failedSet.count(id)) refresh.erase(id);
+}
+
+// ── Snapshot diff ─────────────────────────────────────────────────────────────
+
+// Recomputes the session deltas from the baseline and the normalised new
+// snapshot, and registers icons for rows shown for the first time.  Caller
+// holds s_Mutex.
+static void DiffAgainstBase(const SnapshotDiff::ItemColumns& cur,
+                            const SnapshotDiff::WalletColumns& wallet)
+{
+    s_NewlyShown.clear();
+    SnapshotDiff::DiffWallet(s_BaseWallet, wallet, s_DeltaWallet, s_NewlyShown);
+    for (int id : s_NewlyShown) EnsureCurrencyIcon(id);
+
+    s_NewlyShown.clear();
+    SnapshotDiff::DiffItems(s_DeltaItems, cur, s_NewlyShown);
+    for (int id : s_NewlyShown) EnsureItemIcon(id);
+}
+
+// ── Resolver thread ───────────────────────────────────────────────────────────
+// Resolves queued IDs independently of the snapshot loop.  After the first ID
+// arrives it waits until the queue has been quiet for RESOLVE_QUIET (capped at
+// RESOLVE_MAX_WAIT), so a burst — a new snapshot's worth of drops, or several
+// items added by ID — goes out as one /v2/items request per 200 IDs.
+// IDs from a failed batch are queued again and retried after a backoff
+// (RESOLVE_RETRY_MIN, doubling up to RESOLVE_RETRY_MAX); IDs the API answers
+// for but doesn't know are dropped.
+
+static const auto RESOLVE_QUIET     = std::chrono::milliseconds(750);
+static const auto RESOLVE_MAX_WAIT  = std::chrono::milliseconds(3000);
+static const auto RESOLVE_RETRY_MIN = std::chrono::seconds(5);
+static const auto RESOLVE_RETRY_MAX = std::chrono::seconds(120);
+
+static void ResolverLoop()
+{
+    std::unique_lock<std::mutex> lock(s_Mutex);
+    while (!s_Stopping)
+    {
+        s_ResolverCv.wait(lock, []
         {
-            s_CurrencyInfo[c.id] = c;
-            s_PendingCurrencyIds.erase(c.id);
+            return s_Stopping || !s_PendingItemIds.empty() || !s_PendingCurrencyIds.empty();
+        });
+        if (s_Stopping) break;
 
-            if (APIDefs && !c.iconUrl.empty())
-            {
-                std::string texId = "LT_CURRENCY_" + std::to_string(c.id);
-                const std::string host = "https://render.guildwars2.com";
-                std::string path = c.iconUrl;
-                if (path.rfind(host, 0) == 0)
-                    path = path.substr(host.size());
-
-                APIDefs->Textures_LoadFromURL(texId.c_str(),
-                    "https://render.guildwars2.com",
-                    path.c_str(),
-                    nullptr);
-            }
+        // Batching window.
+        const Clock::time_point first = Clock::now();
+        while (!s_Stopping)
+        {
+            Clock::time_point until = std::max(std::min(s_LastQueuedAt + RESOLVE_QUIET,
+                                                        first + RESOLVE_MAX_WAIT),
+                                               s_RetryAt);
+            if (Clock::now() >= until) break;
+            s_ResolverCv.wait_until(lock, until);
         }
+        if (s_Stopping) break;
+
+        std::vector<int> needItems(s_PendingItemIds.begin(),         s_PendingItemIds.end());
+        std::vector<int> needCurrencies(s_PendingCurrencyIds.begin(), s_PendingCurrencyIds.end());
+        s_InFlightItemIds.insert(needItems.begin(), needItems.end());
+        s_InFlightCurrencyIds.insert(needCurrencies.begin(), needCurrencies.end());
+        s_PendingItemIds.clear();
+        s_PendingCurrencyIds.clear();
+        lock.unlock();
+
+        // HTTP calls block — s_Mutex is free while they run.
+        const Clock::time_point t0 = Clock::now();
+        std::vector<int> failedItems, failedCurrencies;
+        if (!needItems.empty())
+            GW2Api::FetchItemDetails(needItems, GW2Api::RequestPriority::Metadata,
+                                     PublishItemInfos, &failedItems);
+        if (!needCurrencies.empty())
+            GW2Api::FetchCurrencyDetails(needCurrencies, GW2Api::RequestPriority::Metadata,
+                                         PublishCurrencyInfos, &failedCurrencies);
+
+        if (APIDefs)
+        {
+            char buf[160];
+            snprintf(buf, sizeof(buf),
+                     "Resolved %zu item + %zu currency IDs in %lld ms (%zu + %zu failed).",
+                     needItems.size(), needCurrencies.size(),
+                     (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
+                         Clock::now() - t0).count(),
+                     failedItems.size(), failedCurrencies.size());
+            APIDefs->Log(failedItems.empty() && failedCurrencies.empty() ? LOGL_DEBUG
+                                                                         : LOGL_WARNING,
+                         "LootTracker", buf);
+        }
+
+        lock.lock();
+        s_InFlightItemIds.clear();
+        s_InFlightCurrencyIds.clear();
+        NoteRefreshed(needItems,      failedItems,      s_RefreshItemIds);
+        NoteRefreshed(needCurrencies, failedCurrencies, s_RefreshCurrencyIds);
+        FinishRefreshIfDone();
+        if (failedItems.empty() && failedCurrencies.empty())
+            s_RetryDelay = {};
+        else
+        {
+            s_RetryDelay = s_RetryDelay == Clock::duration{}
+                         ? Clock::duration(RESOLVE_RETRY_MIN)
+                         : std::min<Clock::duration>(s_RetryDelay * 2, RESOLVE_RETRY_MAX);
+            s_RetryAt = Clock::now() + s_RetryDelay;
+            s_PendingItemIds.insert(failedItems.begin(), failedItems.end());
+            s_PendingCurrencyIds.insert(failedCurrencies.begin(), failedCurrencies.end());
+        }
+        lock.unlock();
+
+        SaveMetadataIfDirty();
+        lock.lock();
     }
 }
 
@@ -126,44 +479,55 @@ static void ResolveNewIds()
 
 void LootSession::Init()
 {
-    // ── Pre-populate info cache from saved history so the profile editor
-    // already has items/currencies to show even before the first poll ────────
+    // ── Load metadata.bin — known IDs resolve without any API traffic ─────────
+    bool warm = false;
     {
+        MetadataCache::LoadResult cached;
+        bool     loaded = MetadataCache::Load(cached);
+        uint32_t build  = MumbleLink ? MumbleLink->Context.BuildId : 0;
+        // Build 0 means Mumble isn't up yet; CheckMetadataBuild decides later.
+        warm = loaded && (build == 0 || cached.buildId == build);
+
+        // The catalog interns what it needs; the decoded copies go with
+        // `cached` at the end of this block.
         std::lock_guard<std::mutex> lock(s_Mutex);
-        for (auto& sess : SessionHistory::GetAll())
+        if (warm)
         {
-            for (auto& item : sess.items)
-            {
-                if (s_ItemInfo.find(item.id) == s_ItemInfo.end())
-                {
-                    GW2Api::ItemInfo info;
-                    info.id          = item.id;
-                    info.name        = item.name;
-                    info.rarity      = item.rarity;
-                    info.type        = item.type;
-                    info.description = item.description;
-                    info.vendorValue = item.vendorValue;
-                    s_ItemInfo[item.id] = info;
-                }
-            }
-            for (auto& c : sess.currencies)
-            {
-                if (s_CurrencyInfo.find(c.id) == s_CurrencyInfo.end())
-                {
-                    GW2Api::CurrencyInfo info;
-                    info.id   = c.id;
-                    info.name = c.name;
-                    s_CurrencyInfo[c.id] = info;
-                }
-            }
+            for (auto& i : cached.items)      Catalog::UpdateItem(i);
+            for (auto& c : cached.currencies) Catalog::UpdateCurrency(c);
+            s_MetadataBuild = cached.buildId;
+            s_MetadataFlags = cached.flags;
+        }
+        MetadataCache::NoteStartup(warm);
+
+        if (APIDefs)
+        {
+            MetadataCache::Stats st = MetadataCache::GetStats();
+            char buf[192];
+            if (warm)
+                snprintf(buf, sizeof(buf),
+                    "Metadata cache warm: %zu items + %zu currencies in %.1f ms (build %u).",
+                    st.itemsLoaded, st.currenciesLoaded, st.loadMs, st.fileBuildId);
+            else
+                snprintf(buf, sizeof(buf), loaded
+                    ? "Metadata cache cold: written under build %u, game is %u."
+                    : "Metadata cache cold: no usable metadata.bin.",
+                    st.fileBuildId, build);
+            APIDefs->Log(LOGL_INFO, "LootTracker", buf);
         }
     }
 
+    // SessionHistory::Load() has already restored every history entry into
+    // the catalog, so the profile editor has items and currencies to show
+    // before the first poll.
+
+    s_ResolverThread = std::thread(ResolverLoop);
+
     // Wire the polling thread callback.
-    GW2Api::StartPolling([](GW2Api::Snapshot snap)
+    GW2Api::StartPolling([](GW2Api::Snapshot& snap)
     {
         LootSession::CheckAutoStart();
-        LootSession::OnSnapshot(std::move(snap));
+        LootSession::OnSnapshot(snap);
     });
 
     // Pre-fetch all GW2 currencies in the background so the profile editor
@@ -179,47 +543,60 @@ void LootSession::Init()
             auto profiles = TrackingFilter::GetProfilesCopy();
             for (auto& p : profiles)
                 for (int id : p.itemIds)
-                    if (s_ItemInfo.find(id) == s_ItemInfo.end())
+                    if (!Catalog::FindItem(id))
                         unknownProfileItems.push_back(id);
         }
         if (!unknownProfileItems.empty())
         {
-            {
-                std::lock_guard<std::mutex> lock(s_Mutex);
-                for (int id : unknownProfileItems)
-                    s_PendingItemIds.insert(id);
-            }
-            ResolveNewIds();
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            for (int id : unknownProfileItems)
+                QueueItem(id);
         }
 
         // ── Pre-fetch all currencies ─────────────────────────────────────────
-        auto all = GW2Api::FetchAllCurrencies();
-        if (all.empty()) return;
-
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        for (auto& c : all)
+        // Skipped only when metadata.bin says it holds the complete list.  A
+        // cold start, a file from before the flag, or an earlier prefetch that
+        // failed part-way all fetch it again.
+        bool haveAll;
         {
-            if (s_CurrencyInfo.find(c.id) != s_CurrencyInfo.end()) continue;
-            s_CurrencyInfo[c.id] = c;
-
-            if (!s_Stopping && APIDefs && !c.iconUrl.empty())
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            haveAll = (s_MetadataFlags & MetadataCache::FLAG_ALL_CURRENCIES) != 0;
+        }
+        if (!haveAll && !s_Stopping)
+        {
+            bool complete = false;
+            auto all = GW2Api::FetchAllCurrencies(&complete);
+            if (!all.empty())
             {
-                std::string texId = "LT_CURRENCY_" + std::to_string(c.id);
-                const std::string host = "https://render.guildwars2.com";
-                std::string path = c.iconUrl;
-                if (path.rfind(host, 0) == 0) path = path.substr(host.size());
-                APIDefs->Textures_LoadFromURL(texId.c_str(),
-                    "https://render.guildwars2.com", path.c_str(), nullptr);
+                {
+                    std::lock_guard<std::mutex> lock(s_Mutex);
+                    for (auto& c : all)
+                    {
+                        const Catalog::Currency* known = Catalog::FindCurrency(c.id);
+                        if (known && !known->iconUrl.empty()) continue;
+                        const Catalog::Currency* e = Catalog::UpdateCurrency(c);
+                        s_CurrencyIconsRequested.insert(c.id);
+                        LoadIconTexture(e->textureId, e->iconUrl);
+                    }
+                    if (complete) s_MetadataFlags |= MetadataCache::FLAG_ALL_CURRENCIES;
+                    s_MetadataDirty = true;
+                    PublishDeltaView();
+                }
+                MetadataCache::NoteFetched(0, all.size());
+                SaveMetadataIfDirty();
             }
         }
+        if (!s_Stopping) LogMemoryReport("after startup");
     });
 }
 
 void LootSession::Start()
 {
     std::lock_guard<std::mutex> lock(s_Mutex);
-    s_DeltaWallet.clear();
-    s_DeltaItems.clear();
+    SnapshotDiff::Clear(s_DeltaItems);
+    s_DeltaWallet.ids.clear();
+    s_DeltaWallet.delta.clear();
+    PublishDeltaView();
     // Mark that the next snapshot should become the new baseline rather than
     // being diffed against potentially stale data.  s_Active = true immediately
     // so the UI shows the Stop button and the timer starts.
@@ -245,8 +622,7 @@ void LootSession::Stop()
 
     if (wasActive)
     {
-        // GetItemDeltas/GetCurrencyDeltas re-acquire the mutex internally,
-        // so they must be called OUTSIDE the lock block above.
+        // The published view is current — it is rebuilt with every diff.
         auto items      = GetItemDeltas();
         auto currencies = GetCurrencyDeltas();
         SessionHistory::SaveSession(wallStart,
@@ -259,28 +635,31 @@ void LootSession::Stop()
         APIDefs->Log(LOGL_INFO, "LootTracker", "Session stopped.");
 }
 
-void LootSession::OnSnapshot(GW2Api::Snapshot snap)
+void LootSession::OnSnapshot(GW2Api::Snapshot& snap)
 {
-    bool needsResolve = false;
-
-    // ── Phase 1: apply snapshot under the lock ────────────────────────────────
+    // ── Apply snapshot under the lock; new IDs go to the resolver thread ─────
     {
         std::lock_guard<std::mutex> lock(s_Mutex);
+        CheckMetadataBuild();
 
-        // Build lookup maps for the new snapshot
-        std::unordered_map<int, int64_t> newWallet;
-        for (auto& w : snap.wallet)
-            newWallet[w.id] = w.value;
-
-        std::unordered_map<int, int> newItems;
-        for (auto& item : snap.inventory)
-            newItems[item.id] += item.count;
+        const Clock::time_point t0 = Clock::now();
+        SnapshotDiff::NormalizeItems(snap.inventory, s_NewItems);
+        if (SnapshotDiff::NormalizeWallet(snap.wallet, s_NewWallet) > 0 && !s_OverflowLogged && APIDefs)
+        {
+            APIDefs->Log(LOGL_WARNING, "LootTracker",
+                         "Wallet lists a currency ID outside the expected range; tracking it in the overflow list.");
+            s_OverflowLogged = true;
+        }
+        const size_t itemIds = s_NewItems.ids.size(), currencyIds = s_NewWallet.ids.size();
 
         if (!s_HasBase || s_NeedsNewBase)
         {
             // Snapshot is a fresh baseline (first ever, or user clicked Start/Reset).
-            s_BaseWallet   = newWallet;
-            s_BaseItems    = newItems;
+            // Swap rather than copy; the old baseline's buffers are reused
+            // for the next snapshot.  Item counts become the delta rows'
+            // baseline.
+            std::swap(s_BaseWallet, s_NewWallet);
+            SnapshotDiff::Rebase(s_DeltaItems, s_NewItems);
             s_HasBase      = true;
             s_NeedsNewBase = false;
             // Don't force s_Active here — on the very first ever snapshot we
@@ -288,70 +667,51 @@ void LootSession::OnSnapshot(GW2Api::Snapshot snap)
             // already true by the time the baseline snapshot arrives.
 
             // Queue all currencies for info fetch
-            for (auto& [id, _] : newWallet)
-                if (s_CurrencyInfo.find(id) == s_CurrencyInfo.end())
-                    s_PendingCurrencyIds.insert(id);
+            for (int id : s_BaseWallet.ids) EnsureCurrencyIcon(id);
         }
         else if (s_Active)
         {
             // Compute deltas relative to baseline this session
-            for (auto& [id, val] : newWallet)
-            {
-                int64_t base = 0;
-                auto it = s_BaseWallet.find(id);
-                if (it != s_BaseWallet.end()) base = it->second;
-                s_DeltaWallet[id] = val - base;
-
-                if (s_CurrencyInfo.find(id) == s_CurrencyInfo.end())
-                    s_PendingCurrencyIds.insert(id);
-            }
-
-            for (auto& [id, cnt] : newItems)
-            {
-                int base = 0;
-                auto it = s_BaseItems.find(id);
-                if (it != s_BaseItems.end()) base = it->second;
-                int d = cnt - base;
-                if (d != 0)
-                {
-                    s_DeltaItems[id] = d;
-                    if (s_ItemInfo.find(id) == s_ItemInfo.end())
-                        s_PendingItemIds.insert(id);
-                }
-            }
-            // Items that were at baseline but not in the new snapshot (fully gone)
-            for (auto& [id, base] : s_BaseItems)
-            {
-                if (newItems.find(id) == newItems.end())
-                {
-                    s_DeltaItems[id] = -base;
-                    if (s_ItemInfo.find(id) == s_ItemInfo.end())
-                        s_PendingItemIds.insert(id);
-                }
-            }
+            DiffAgainstBase(s_NewItems, s_NewWallet);
+            PublishDeltaView();
         }
 
-        needsResolve = !s_PendingItemIds.empty() || !s_PendingCurrencyIds.empty();
-    } // lock released here
-
-    // ── Phase 2: resolve new IDs without holding the lock (HTTP calls block) ──
-    if (needsResolve)
-        ResolveNewIds();
+        if (APIDefs)
+        {
+            char buf[128];
+            snprintf(buf, sizeof(buf), "Snapshot diff + view publish: %zu item IDs, %zu currencies in %.3f ms.",
+                     itemIds, currencyIds,
+                     std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+            APIDefs->Log(LOGL_DEBUG, "LootTracker", buf);
+        }
+    }
 }
 
 void LootSession::Shutdown()
 {
-    // Signal the init thread to abort any APIDefs calls before we join it.
+    // Signal the init thread to abort any APIDefs calls before we join it,
+    // and fail its (and the other threads') pending API requests.
     s_Stopping = true;
+    GW2Api::CancelRequests();
     // Wait for the init (pre-fetch) thread to finish before tearing down.
     if (s_InitThread.joinable()) s_InitThread.join();
     GW2Api::StopPolling();
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex); // don't let the wake-up slip past the wait
+        s_ResolverCv.notify_all();
+    }
+    if (s_ResolverThread.joinable()) s_ResolverThread.join();
+    // Nothing resolves any more; persist what this run learned.
+    SaveMetadataIfDirty();
+    LogMemoryReport("at unload");
     std::lock_guard<std::mutex> lock(s_Mutex);
     s_Active       = false;
     s_HasBase      = false;
     s_NeedsNewBase = false;
-    s_DeltaWallet.clear();
-    s_DeltaItems.clear();
+    SnapshotDiff::Clear(s_DeltaItems);
+    s_DeltaWallet.ids.clear();
+    s_DeltaWallet.delta.clear();
+    PublishDeltaView();
 }
 
 bool LootSession::IsActive()
@@ -427,116 +787,35 @@ std::chrono::seconds LootSession::ElapsedTime()
     return std::chrono::duration_cast<Seconds>(Clock::now() - s_StartTime);
 }
 
-std::vector<LootSession::ItemDelta> LootSession::GetItemDeltas()
+std::shared_ptr<const LootSession::DeltaView> LootSession::GetDeltaView()
 {
-    std::lock_guard<std::mutex> lock(s_Mutex);
-    std::vector<ItemDelta> result;
-    result.reserve(s_DeltaItems.size());
-
-    for (auto& [id, delta] : s_DeltaItems)
-    {
-        ItemDelta d;
-        d.id    = id;
-        d.delta = delta;
-
-        auto it = s_ItemInfo.find(id);
-        if (it != s_ItemInfo.end())
-        {
-            d.name        = it->second.name;
-            d.rarity      = it->second.rarity;
-            d.chatLink    = it->second.chatLink;
-            d.description = it->second.description;
-            d.type        = it->second.type;
-            d.vendorValue = it->second.vendorValue;
-        }
-        else
-        {
-            d.name = "Item #" + std::to_string(id);
-        }
-
-        d.textureId = "LT_ITEM_" + std::to_string(id);
-        result.push_back(std::move(d));
-    }
-
-    // Sort: gained first (descending delta), then losses
-    std::sort(result.begin(), result.end(),
-        [](const ItemDelta& a, const ItemDelta& b){ return a.delta > b.delta; });
+    return std::atomic_load(&s_View);
+}
 
-    return result;
+std::vector<LootSession::ItemDelta> LootSession::GetItemDeltas()
+{
+    return GetDeltaView()->items;
 }
 
 std::vector<LootSession::CurrencyDelta> LootSession::GetCurrencyDeltas()
 {
-    std::lock_guard<std::mutex> lock(s_Mutex);
-    std::vector<CurrencyDelta> result;
-    result.reserve(s_DeltaWallet.size());
-
-    for (auto& [id, delta] : s_DeltaWallet)
-    {
-        if (delta == 0) continue;
-
-        CurrencyDelta d;
-        d.id    = id;
-        d.delta = delta;
-
-        auto it = s_CurrencyInfo.find(id);
-        if (it != s_CurrencyInfo.end())
-            d.name = it->second.name;
-        else
-            d.name = "Currency #" + std::to_string(id);
-
-        d.textureId = "LT_CURRENCY_" + std::to_string(id);
-        result.push_back(std::move(d));
-    }
-
-    std::sort(result.begin(), result.end(),
-        [](const CurrencyDelta& a, const CurrencyDelta& b){ return a.delta > b.delta; });
-
-    return result;
+    return GetDeltaView()->currencies;
 }
 
-std::vector<LootSession::KnownItem> LootSession::GetKnownItems()
+std::vector<const LootSession::KnownItem*> LootSession::GetKnownItems()
 {
-    std::lock_guard<std::mutex> lock(s_Mutex);
-    std::vector<KnownItem> result;
-    result.reserve(s_ItemInfo.size());
-    for (auto& [id, info] : s_ItemInfo)
-    {
-        KnownItem ki;
-        ki.id        = id;
-        ki.name      = info.name;
-        ki.type      = info.type;
-        ki.rarity    = info.rarity;
-        ki.textureId = "LT_ITEM_" + std::to_string(id);
-        result.push_back(std::move(ki));
-    }
-    return result;
+    return Catalog::KnownItems();
 }
 
-std::vector<LootSession::KnownCurrency> LootSession::GetKnownCurrencies()
+std::vector<const LootSession::KnownCurrency*> LootSession::GetKnownCurrencies()
 {
-    std::lock_guard<std::mutex> lock(s_Mutex);
-    std::vector<KnownCurrency> result;
-    result.reserve(s_CurrencyInfo.size());
-    for (auto& [id, info] : s_CurrencyInfo)
-    {
-        KnownCurrency kc;
-        kc.id        = id;
-        kc.name      = info.name;
-        kc.textureId = "LT_CURRENCY_" + std::to_string(id);
-        result.push_back(std::move(kc));
-    }
-    return result;
+    return Catalog::KnownCurrencies();
 }
 
 void LootSession::RequestItemResolution(int id)
 {
     if (id <= 0) return;
-    {
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        if (s_ItemInfo.find(id) != s_ItemInfo.end()) return; // already known
-        s_PendingItemIds.insert(id);
-    }
-    // Wake the poll thread immediately so the name resolves within seconds.
-    GW2Api::PollNow();
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    if (Catalog::FindItem(id)) return; // already known
+    QueueItem(id); // wakes the resolver; no snapshot poll needed
 }
@@ -1,63 +1,59 @@
 #pragma once
 #include "GW2Api.h"
+#include "Catalog.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <chrono>
 #include <mutex>
+#include <memory>
 
 namespace LootSession
 {
     // ── Delta types shown in the UI ───────────────────────────────────────────
 
+    // Name, rarity, texture ID etc. live in the catalog; a delta only points
+    // at the entry that was current when it was computed.
     struct ItemDelta
     {
-        int         id;
-        std::string name;
-        std::string rarity;       // "Fine", "Rare", "Exotic", etc.
-        std::string chatLink;
-        int         delta;        // positive = gained, negative = lost
-        // Texture identifier registered with Nexus Texture API.
-        // Empty until the icon has been loaded asynchronously.
-        std::string textureId;
-        std::string description;  // optional flavour/lore text
-        std::string type;         // item type, e.g. "Weapon", "Armor"
-        int         vendorValue = 0; // copper coins
+        int                  id    = 0;
+        int                  delta = 0;       // positive = gained, negative = lost
+        const Catalog::Item* info  = nullptr; // never null once published
     };
 
     struct CurrencyDelta
     {
-        int         id;
-        std::string name;
-        int64_t     delta;
-        std::string textureId;
+        int                      id    = 0;
+        int64_t                  delta = 0;
+        const Catalog::Currency* info  = nullptr;
     };
 
     // ── Session state accessible to the UI ───────────────────────────────────
 
-    // Returns a thread-safe copy of the current item deltas.
+    // Immutable copy of the session deltas, rebuilt whenever they or the
+    // item/currency info change and swapped in atomically.  Both lists are
+    // pre-sorted, gained first; currencies with a zero delta are left out.
+    struct DeltaView
+    {
+        uint64_t                   version = 0; // increases with every publish
+        std::vector<ItemDelta>     items;
+        std::vector<CurrencyDelta> currencies;
+    };
+
+    // The latest published view.  Never blocks on the session lock, so it is
+    // safe to call every frame from the render thread.  Never null.
+    std::shared_ptr<const DeltaView> GetDeltaView();
+
+    // Copies of the current view's lists.
     std::vector<ItemDelta>     GetItemDeltas();
-    // Returns a thread-safe copy of the current currency deltas.
     std::vector<CurrencyDelta> GetCurrencyDeltas();
 
     // ── Known item/currency database (grows over playtime) ────────────────────
     // Used by the profile editor to show what can be tracked.
-    struct KnownItem
-    {
-        int         id;
-        std::string name;
-        std::string type;
-        std::string rarity;
-        std::string textureId; // "LT_ITEM_{id}"
-    };
-    struct KnownCurrency
-    {
-        int         id;
-        std::string name;
-        std::string textureId; // "LT_CURRENCY_{id}"
-    };
-    std::vector<KnownItem>     GetKnownItems();
-    std::vector<KnownCurrency> GetKnownCurrencies();
+    using KnownItem     = Catalog::Item;
+    using KnownCurrency = Catalog::Currency;
+    std::vector<const KnownItem*>     GetKnownItems();
+    std::vector<const KnownCurrency*> GetKnownCurrencies();
 
     // How long the current session has been running (0 if not active).
     std::chrono::seconds ElapsedTime();
@@ -80,12 +76,12 @@ namespace LootSession
     void CheckAutoStart();
 
     // Called internally by GW2Api polling thread with a fresh snapshot.
-    void OnSnapshot(GW2Api::Snapshot snap);
+    void OnSnapshot(GW2Api::Snapshot& snap);
 
     void Shutdown();
 
     // Queue an item ID for name/icon resolution (for items added to a profile
-    // before they have ever been seen in a session). Triggers a poll so names
-    // appear within seconds rather than waiting up to 30 s.
+    // before they have ever been seen in a session). The resolver thread
+    // batches IDs queued close together into one /v2/items request.
     void RequestItemResolution(int id);
 }
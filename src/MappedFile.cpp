@@ -0,0 +1,70 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+    HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+    m_File = hFile;
+
+    LARGE_INTEGER li;
+    if (!GetFileSizeEx(hFile, &li) || li.QuadPart == 0) { Close(); return false; }
+
+    m_Map = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_Map) { Close(); return false; }
+    m_Data = static_cast<const char*>(MapViewOfFile(m_Map, FILE_MAP_READ, 0, 0, 0));
+    if (!m_Data) { Close(); return false; }
+    m_Size = (size_t)li.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_Data) UnmapViewOfFile(m_Data);
+    if (m_Map)  CloseHandle(m_Map);
+    if (m_File) CloseHandle(m_File);
+    m_Data = nullptr;
+    m_Map  = nullptr;
+    m_File = nullptr;
+    m_Size = 0;
+}
+
+#else
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    // The mapping keeps the file alive; the descriptor isn't needed after.
+    struct stat st;
+    void* p = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+
+    m_Data = static_cast<const char*>(p);
+    m_Size = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_Data) munmap(const_cast<char*>(m_Data), m_Size);
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+// ── Read-only memory-mapped file ──────────────────────────────────────────────
+// File mapping on Windows, mmap elsewhere, so readers of mapped formats
+// (history segments) build in the portable core.  The view stays valid until
+// Close() or destruction.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps the whole of path.  False if it is missing, empty or can't be mapped.
+    bool Open(const std::string& path);
+    void Close();
+
+    const char* Data() const { return m_Data; }
+    size_t      Size() const { return m_Size; }
+
+private:
+    const char* m_Data = nullptr;
+    size_t      m_Size = 0;
+#ifdef _WIN32
+    void*       m_File = nullptr; // HANDLE
+    void*       m_Map  = nullptr; // HANDLE
+#endif
+};
@@ -0,0 +1,229 @@
+#include "MetadataCache.h"
+#include "Shared.h"
+#include "Persist.h"
+#include "MappedFile.h"
+
+#include <windows.h>
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+// ── File layout ───────────────────────────────────────────────────────────────
+// Little-endian, no padding:
+//
+//   FileHeader
+//   itemCount     × { i32 id, i32 vendorValue, str name, str rarity, str icon,
+//                     str chatLink, str description, str type }
+//   currencyCount × { i32 id, str name, str icon }
+//
+// where str = u16 byte length followed by UTF-8 bytes.
+
+static const char     MAGIC[4] = { 'L', 'T', 'M', 'C' };
+static const uint32_t VERSION  = 1;
+
+#pragma pack(push, 1)
+struct FileHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t buildId;
+    uint32_t itemCount;
+    uint32_t currencyCount;
+    uint32_t flags;        // MetadataCache::FLAG_*
+};
+#pragma pack(pop)
+
+static std::mutex            s_StatsMutex;
+static MetadataCache::Stats  s_Stats;
+static std::mutex            s_SaveMutex; // one writer at a time (shared temp file)
+
+static std::string CachePath()
+{
+    if (!APIDefs || !APIDefs->Paths_GetAddonDirectory) return "";
+    std::string dir = APIDefs->Paths_GetAddonDirectory("LootTracker");
+    CreateDirectoryA(dir.c_str(), nullptr);
+    return dir + "\\metadata.bin";
+}
+
+// ── Decoding ──────────────────────────────────────────────────────────────────
+
+namespace
+{
+    // Bounds-checked cursor over the mapped file.
+    struct Reader
+    {
+        const char* p;
+        const char* end;
+        bool        ok = true;
+
+        bool Need(size_t n)
+        {
+            if (ok && (size_t)(end - p) < n) ok = false;
+            return ok;
+        }
+
+        uint32_t U32()
+        {
+            uint32_t v = 0;
+            if (Need(4)) { memcpy(&v, p, 4); p += 4; }
+            return v;
+        }
+
+        int32_t I32() { return (int32_t)U32(); }
+
+        std::string Str()
+        {
+            uint16_t len = 0;
+            if (!Need(2)) return {};
+            memcpy(&len, p, 2); p += 2;
+            if (!Need(len)) return {};
+            std::string s(p, len);
+            p += len;
+            return s;
+        }
+    };
+}
+
+bool MetadataCache::Load(LoadResult& out)
+{
+    out = LoadResult{};
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::string path = CachePath();
+    if (path.empty()) return false;
+
+    MappedFile file;
+    if (!file.Open(path) || file.Size() < sizeof(FileHeader)) return false;
+
+    FileHeader hdr{};
+    memcpy(&hdr, file.Data(), sizeof(FileHeader));
+    if (memcmp(hdr.magic, MAGIC, 4) != 0 || hdr.version != VERSION) return false;
+
+    Reader r{ file.Data() + sizeof(FileHeader), file.Data() + file.Size() };
+
+    // Every record is at least 8 bytes; don't trust counts beyond that.
+    size_t maxRecords = file.Size() / 8;
+    out.items.reserve(std::min<size_t>(hdr.itemCount, maxRecords));
+    for (uint32_t i = 0; i < hdr.itemCount && r.ok; ++i)
+    {
+        GW2Api::ItemInfo info;
+        info.id          = r.I32();
+        info.vendorValue = r.I32();
+        info.name        = r.Str();
+        info.rarity      = r.Str();
+        info.iconUrl     = r.Str();
+        info.chatLink    = r.Str();
+        info.description = r.Str();
+        info.type        = r.Str();
+        if (r.ok) out.items.push_back(std::move(info));
+    }
+
+    out.currencies.reserve(std::min<size_t>(hdr.currencyCount, maxRecords));
+    for (uint32_t i = 0; i < hdr.currencyCount && r.ok; ++i)
+    {
+        GW2Api::CurrencyInfo info;
+        info.id      = r.I32();
+        info.name    = r.Str();
+        info.iconUrl = r.Str();
+        if (r.ok) out.currencies.push_back(std::move(info));
+    }
+
+    if (!r.ok)
+    {
+        // Truncated or corrupt — start cold rather than trust half a file.
+        out = LoadResult{};
+        return false;
+    }
+    out.buildId = hdr.buildId;
+    out.flags   = hdr.flags;
+
+    std::lock_guard<std::mutex> lock(s_StatsMutex);
+    s_Stats.fileBuildId      = hdr.buildId;
+    s_Stats.itemsLoaded      = out.items.size();
+    s_Stats.currenciesLoaded = out.currencies.size();
+    s_Stats.loadMs = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - t0).count();
+    return true;
+}
+
+// ── Encoding ──────────────────────────────────────────────────────────────────
+
+static void PutU32(std::string& buf, uint32_t v) { buf.append((const char*)&v, 4); }
+
+static void PutStr(std::string& buf, std::string_view s)
+{
+    uint16_t len = (uint16_t)std::min<size_t>(s.size(), 0xFFFF);
+    buf.append((const char*)&len, 2);
+    buf.append(s.data(), len);
+}
+
+void MetadataCache::Save(uint32_t buildId, uint32_t flags,
+                         const std::vector<const Catalog::Item*>&     items,
+                         const std::vector<const Catalog::Currency*>& currencies)
+{
+    std::string path = CachePath();
+    if (path.empty()) return;
+
+    std::string buf;
+    buf.reserve(sizeof(FileHeader) + items.size() * 160 + currencies.size() * 96);
+    buf.resize(sizeof(FileHeader));
+
+    FileHeader hdr;
+    memcpy(hdr.magic, MAGIC, 4);
+    hdr.version       = VERSION;
+    hdr.buildId       = buildId;
+    hdr.itemCount     = 0;
+    hdr.currencyCount = 0;
+    hdr.flags         = flags;
+
+    for (const Catalog::Item* info : items)
+    {
+        if (info->iconUrl.empty()) continue;
+        PutU32(buf, (uint32_t)info->id);
+        PutU32(buf, (uint32_t)info->vendorValue);
+        PutStr(buf, info->name);
+        PutStr(buf, Catalog::RarityName(*info));
+        PutStr(buf, info->iconUrl);
+        PutStr(buf, info->chatLink);
+        PutStr(buf, info->description);
+        PutStr(buf, Catalog::TypeName(*info));
+        ++hdr.itemCount;
+    }
+    for (const Catalog::Currency* info : currencies)
+    {
+        if (info->iconUrl.empty()) continue;
+        PutU32(buf, (uint32_t)info->id);
+        PutStr(buf, info->name);
+        PutStr(buf, info->iconUrl);
+        ++hdr.currencyCount;
+    }
+    memcpy(&buf[0], &hdr, sizeof(hdr));
+
+    // Write beside the real file and swap, so a crash mid-write never leaves
+    // a truncated cache behind.
+    std::lock_guard<std::mutex> lock(s_SaveMutex);
+    Persist::WriteFileAtomic(path, buf);
+}
+
+// ── Stats ─────────────────────────────────────────────────────────────────────
+
+MetadataCache::Stats MetadataCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(s_StatsMutex);
+    return s_Stats;
+}
+
+void MetadataCache::NoteStartup(bool warm)
+{
+    std::lock_guard<std::mutex> lock(s_StatsMutex);
+    s_Stats.warm = warm;
+}
+
+void MetadataCache::NoteFetched(size_t items, size_t currencies)
+{
+    std::lock_guard<std::mutex> lock(s_StatsMutex);
+    s_Stats.itemsFetched      += items;
+    s_Stats.currenciesFetched += currencies;
+}
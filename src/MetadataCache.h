@@ -0,0 +1,59 @@
+#pragma once
+#include "GW2Api.h"
+#include "Catalog.h"
+
+#include <vector>
+#include <cstdint>
+
+// ── Persistent item / currency metadata ───────────────────────────────────────
+// Everything /v2/items and /v2/currencies told us, kept in
+// <addondir>/metadata.bin so known IDs resolve at startup without touching the
+// network.  The file records the game build it was written under; a different
+// Mumble Context.BuildId means item data may have changed and the entries are
+// treated as stale.
+namespace MetadataCache
+{
+    // Header flags.
+    enum : uint32_t
+    {
+        FLAG_ALL_CURRENCIES = 1u << 0, // holds the complete /v2/currencies list
+    };
+
+    struct LoadResult
+    {
+        uint32_t                          buildId = 0; // build the file was written under
+        uint32_t                          flags   = 0; // FLAG_*
+        std::vector<GW2Api::ItemInfo>     items;
+        std::vector<GW2Api::CurrencyInfo> currencies;
+    };
+
+    // Memory-maps metadata.bin and decodes it.  Returns false (and an empty
+    // result) when there is no usable file.
+    bool Load(LoadResult& out);
+
+    // Rewrites metadata.bin (temp file + rename) from catalog entries.
+    // Entries without an icon URL were only ever seen in history, not
+    // resolved from the API, and are left out.  Blocking; call from a
+    // background thread or on unload.
+    void Save(uint32_t buildId, uint32_t flags,
+              const std::vector<const Catalog::Item*>&     items,
+              const std::vector<const Catalog::Currency*>& currencies);
+
+    // ── Cold vs warm start ────────────────────────────────────────────────────
+    struct Stats
+    {
+        bool     warm              = false; // cache matched the running build
+        uint32_t fileBuildId       = 0;
+        size_t   itemsLoaded       = 0;
+        size_t   currenciesLoaded  = 0;
+        double   loadMs            = 0.0;
+        uint64_t itemsFetched      = 0;     // resolved from the API since startup
+        uint64_t currenciesFetched = 0;
+    };
+    Stats GetStats();
+
+    // Called by LootSession once it has decided whether the load was usable.
+    void NoteStartup(bool warm);
+    // Called for every batch resolved from the API.
+    void NoteFetched(size_t items, size_t currencies);
+}
@@ -0,0 +1,4 @@
+#include "Mumble.h"
+
+Mumble::LinkedMem* MumbleLink  = nullptr;
+Mumble::Identity*  MumbleIdent = nullptr;
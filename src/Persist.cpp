@@ -0,0 +1,129 @@
+#include "Persist.h"
+#include "Shared.h"
+
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <map>
+#include <algorithm>
+
+using Clock = std::chrono::steady_clock;
+
+// ── Internal state ─────────────────────────────────────────────────────────────
+
+static const auto SAVE_QUIET    = std::chrono::milliseconds(500); // write once saves pause this long
+static const auto SAVE_MAX_WAIT = std::chrono::seconds(2);        // ... or this long after the first
+
+struct PendingFile
+{
+    std::function<std::string()> serialize;
+    int                          saves = 0; // Schedule() calls folded into this write
+};
+
+static std::mutex                         s_Mutex;
+static std::condition_variable            s_Cv;
+static std::map<std::string, PendingFile> s_Pending;  // by file name
+static Clock::time_point                  s_LastScheduledAt;
+static bool                               s_Stopping = false; // flush, then exit
+static std::thread                        s_Thread;
+
+// ── Writer thread ──────────────────────────────────────────────────────────────
+
+static void WriteOne(const std::string& file, PendingFile& pending)
+{
+    if (!APIDefs || !APIDefs->Paths_GetAddonDirectory) return;
+
+    auto t0 = Clock::now();
+    std::string dir = APIDefs->Paths_GetAddonDirectory("LootTracker");
+    CreateDirectoryA(dir.c_str(), nullptr);
+
+    std::string data = pending.serialize();
+    bool ok = Persist::WriteFileAtomic(dir + "\\" + file, data);
+
+    char buf[160];
+    snprintf(buf, sizeof(buf), ok
+        ? "Saved %s (%d saves coalesced, %zu bytes) in %.2f ms."
+        : "Saving %s (%d saves coalesced, %zu bytes) failed after %.2f ms.",
+        file.c_str(), pending.saves, data.size(),
+        std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+    APIDefs->Log(ok ? LOGL_DEBUG : LOGL_WARNING, "LootTracker", buf);
+}
+
+static void WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(s_Mutex);
+    for (;;)
+    {
+        s_Cv.wait(lock, [] { return s_Stopping || !s_Pending.empty(); });
+        if (s_Pending.empty()) break; // stopping with nothing left to flush
+
+        // Debounce; a flush cuts it short.
+        const Clock::time_point first = Clock::now();
+        while (!s_Stopping)
+        {
+            Clock::time_point until = std::min(s_LastScheduledAt + SAVE_QUIET,
+                                               first + SAVE_MAX_WAIT);
+            if (Clock::now() >= until) break;
+            s_Cv.wait_until(lock, until);
+        }
+
+        std::map<std::string, PendingFile> batch;
+        batch.swap(s_Pending);
+        lock.unlock();
+
+        for (auto& [file, pending] : batch) WriteOne(file, pending);
+
+        lock.lock();
+    }
+}
+
+// ── Public API ─────────────────────────────────────────────────────────────────
+
+void Persist::Schedule(const std::string& file, std::function<std::string()> serialize)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        PendingFile& pending = s_Pending[file];
+        pending.serialize = std::move(serialize);
+        ++pending.saves;
+        s_LastScheduledAt = Clock::now();
+
+        if (!s_Thread.joinable())
+        {
+            s_Stopping = false;
+            s_Thread   = std::thread(WriterLoop);
+        }
+    }
+    s_Cv.notify_one();
+}
+
+void Persist::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Stopping = true;
+    }
+    s_Cv.notify_all();
+    if (s_Thread.joinable()) s_Thread.join();
+}
+
+bool Persist::WriteFileAtomic(const std::string& path, const std::string& data)
+{
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f.is_open()) return false;
+        f.write(data.data(), (std::streamsize)data.size());
+        // The last of the data reaches the disk in close(); a failure there
+        // (disk full) must not rename a truncated file over the good one.
+        f.close();
+        if (f.fail())
+        {
+            DeleteFileA(tmp.c_str());
+            return false;
+        }
+    }
+    return MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <functional>
+
+// ── Debounced write-behind for small state files ──────────────────────────────
+// Settings and tracking profiles are saved on every toggle and edit, mostly
+// from the render and input threads.  Save() schedules the file instead of
+// writing it: a background thread waits for saves to go quiet, calls the
+// serializer once, and replaces the file atomically.  A burst of saves to one
+// file costs one write.
+namespace Persist
+{
+    // Schedules <addondir>/file to be rewritten with serialize()'s result.
+    // serialize runs on the writer thread, so it must only touch a snapshot
+    // or state behind its own lock.  A later call for the same file replaces
+    // an earlier one that hasn't been written yet.
+    void Schedule(const std::string& file, std::function<std::string()> serialize);
+
+    // Writes everything scheduled and stops the writer thread (called at
+    // addon unload, after the final saves).  A later Schedule() restarts it.
+    void Shutdown();
+
+    // Writes data beside path and renames it over path, so readers never see
+    // half a file.  If the write fails, path is left as it was and the
+    // partial copy is deleted.
+    bool WriteFileAtomic(const std::string& path, const std::string& data);
+}
@@ -0,0 +1,270 @@
+#include "HttpTransport.h"
+
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+
+// ── Capture files ─────────────────────────────────────────────────────────────
+// <dir>/<fnv64(path)>.<n>.http, where n counts the captures of that path:
+//
+//   LTREC 1
+//   path /v2/account/bank
+//   status 200
+//   etag "8f3c..."
+//   last-modified Tue, 01 Oct 2024 10:00:00 GMT
+//   content-encoding gzip
+//   length 48213
+//   <blank line>
+//   <body as received, exactly `length` bytes>
+
+namespace
+{
+    struct Capture
+    {
+        int         status = 0;
+        std::string etag;
+        std::string lastModified;
+        std::string encoding; // Content-Encoding of body
+        std::string body;
+    };
+
+    std::string NarrowPath(const std::wstring& path)
+    {
+        return std::string(path.begin(), path.end()); // API paths are ASCII
+    }
+
+    std::string CaptureFile(const std::string& dir, const std::string& path, int index)
+    {
+        uint64_t h = 1469598103934665603ull;
+        for (char c : path) { h ^= (unsigned char)c; h *= 1099511628211ull; }
+        char name[48];
+        snprintf(name, sizeof(name), "%016llx.%d.http", (unsigned long long)h, index);
+        return (std::filesystem::path(dir) / name).string();
+    }
+
+    bool WriteCapture(const std::string& file, const std::string& path, const Capture& c)
+    {
+        std::ofstream f(file, std::ios::binary);
+        if (!f.is_open()) return false;
+        f << "LTREC 1\n"
+          << "path "             << path           << "\n"
+          << "status "           << c.status       << "\n"
+          << "etag "             << c.etag         << "\n"
+          << "last-modified "    << c.lastModified << "\n"
+          << "content-encoding " << c.encoding     << "\n"
+          << "length "           << c.body.size()  << "\n\n";
+        f.write(c.body.data(), (std::streamsize)c.body.size());
+        return f.good();
+    }
+
+    std::shared_ptr<const Capture> ReadCapture(const std::string& file)
+    {
+        std::ifstream f(file, std::ios::binary);
+        if (!f.is_open()) return nullptr;
+
+        std::string line;
+        if (!std::getline(f, line) || line != "LTREC 1") return nullptr;
+
+        auto   c      = std::make_shared<Capture>();
+        size_t length = 0;
+        try
+        {
+            while (std::getline(f, line) && !line.empty())
+            {
+                size_t sp = line.find(' ');
+                std::string key   = line.substr(0, sp);
+                std::string value = sp == std::string::npos ? "" : line.substr(sp + 1);
+                if      (key == "status")           c->status       = std::stoi(value);
+                else if (key == "etag")             c->etag         = value;
+                else if (key == "last-modified")    c->lastModified = value;
+                else if (key == "content-encoding") c->encoding     = value;
+                else if (key == "length")           length          = (size_t)std::stoull(value);
+            }
+        }
+        catch (...) { return nullptr; } // hand-edited or truncated header
+
+        c->body.resize(length);
+        f.read(&c->body[0], (std::streamsize)length);
+        if ((size_t)f.gcount() != length) return nullptr;
+        return c;
+    }
+
+    // Answers req from a capture exactly as a live transport would: 304 for
+    // matching validators, otherwise the body inflated via onData, the arena
+    // or Response::body.  Counted in the transfer stats here and only here.
+    bool Serve(const Capture& c, const Http::Request& req, Http::Response& out)
+    {
+        out.status       = c.status;
+        out.body.clear();
+        out.etag         = c.etag;
+        out.lastModified = c.lastModified;
+        out.contentEncoding.clear();
+
+        bool notModified = c.status == 200 &&
+            ((!req.ifNoneMatch.empty() && req.ifNoneMatch == c.etag) ||
+             ( req.ifNoneMatch.empty() && !req.ifModifiedSince.empty() &&
+               req.ifModifiedSince == c.lastModified));
+        if (notModified)
+        {
+            out.status = 304;
+            return true;
+        }
+
+        bool stream = req.onData && c.status >= 200 && c.status < 300;
+        Http::BodyDecoder::Sink toBody = [&out, &req](const char* data, size_t len)
+        {
+            if (req.arena) req.arena->Append(data, len);
+            else           out.body.append(data, len);
+        };
+
+        Http::BodyDecoder  ownDecoder;
+        Http::BodyDecoder& decoder = req.arena ? req.arena->Decoder() : ownDecoder;
+        decoder.Begin(c.encoding, stream ? req.onData : toBody);
+        if (req.arena && !stream)
+        {
+            req.arena->Clear();
+            req.arena->Reserve(c.body.size());
+        }
+
+        // Same chunking a socket read would produce, so streaming parsers see
+        // realistic boundaries.
+        const size_t CHUNK = 16 * 1024;
+        for (size_t i = 0; i < c.body.size(); i += CHUNK)
+            decoder.Write(c.body.data() + i, std::min(CHUNK, c.body.size() - i));
+        return decoder.Finish();
+    }
+
+    class RecordingTransport : public Http::ITransport
+    {
+    public:
+        RecordingTransport(std::shared_ptr<Http::ITransport> inner, std::string dir)
+            : m_Inner(std::move(inner)), m_Dir(std::move(dir))
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(m_Dir, ec);
+        }
+
+        bool Get(const Http::Request& req, Http::Response& out) override
+        {
+            // Unconditional copy of the request, body kept as received.
+            Http::Request full;
+            full.path   = req.path;
+            full.apiKey = req.apiKey;
+            full.raw    = true;
+            Http::Response resp;
+            if (!m_Inner->Get(full, resp)) return false;
+
+            Capture c;
+            c.status       = resp.status;
+            c.etag         = std::move(resp.etag);
+            c.lastModified = std::move(resp.lastModified);
+            c.encoding     = std::move(resp.contentEncoding);
+            c.body         = std::move(resp.body);
+
+            std::string path = NarrowPath(req.path);
+            int index;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                index = m_Next[path]++;
+            }
+            WriteCapture(CaptureFile(m_Dir, path, index), path, c);
+
+            return Serve(c, req, out);
+        }
+
+        void Close() override { m_Inner->Close(); }
+
+    private:
+        std::shared_ptr<Http::ITransport> m_Inner;
+        const std::string                 m_Dir;
+
+        std::mutex                 m_Mutex;
+        std::map<std::string, int> m_Next; // path -> next capture index
+    };
+
+    class ReplayTransport : public Http::ITransport
+    {
+    public:
+        ReplayTransport(std::string dir, int latencyMs)
+            : m_Dir(std::move(dir)), m_LatencyMs(std::max(0, latencyMs)) {}
+
+        bool Get(const Http::Request& req, Http::Response& out) override
+        {
+            if (m_LatencyMs > 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_LatencyMs));
+
+            std::shared_ptr<const Capture> c = Next(NarrowPath(req.path));
+            if (!c)
+            {
+                out.status = 404;
+                out.body.clear();
+                out.etag.clear();
+                out.lastModified.clear();
+                out.contentEncoding.clear();
+                return true;
+            }
+            return Serve(*c, req, out);
+        }
+
+        // Captures stay loaded; there is nothing pooled to drop.
+        void Close() override {}
+
+    private:
+        // Next capture of path in recorded order, holding on the last one.
+        // Files are read once and then served from memory, so disk speed
+        // doesn't leak into measurements.
+        std::shared_ptr<const Capture> Next(const std::string& path)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            Sequence& seq = m_Sequences[path];
+            if (!seq.exhausted)
+            {
+                int index = (int)seq.captures.size();
+                if (seq.next == index)
+                {
+                    auto c = ReadCapture(CaptureFile(m_Dir, path, index));
+                    if (c) seq.captures.push_back(std::move(c));
+                    else   seq.exhausted = true;
+                }
+            }
+            if (seq.captures.empty()) return nullptr;
+
+            int i = std::min(seq.next, (int)seq.captures.size() - 1);
+            if (seq.next < (int)seq.captures.size()) ++seq.next;
+            return seq.captures[i];
+        }
+
+        struct Sequence
+        {
+            std::vector<std::shared_ptr<const Capture>> captures;
+            int  next      = 0;
+            bool exhausted = false; // no capture file beyond captures.size()
+        };
+
+        const std::string m_Dir;
+        const int         m_LatencyMs;
+
+        std::mutex                      m_Mutex;
+        std::map<std::string, Sequence> m_Sequences;
+    };
+}
+
+std::unique_ptr<Http::ITransport> Http::CreateRecordingTransport(std::shared_ptr<ITransport> inner,
+                                                                 const std::string&          dir)
+{
+    return std::make_unique<RecordingTransport>(std::move(inner), dir);
+}
+
+std::unique_ptr<Http::ITransport> Http::CreateReplayTransport(const std::string& dir, int latencyMs)
+{
+    return std::make_unique<ReplayTransport>(dir, latencyMs);
+}
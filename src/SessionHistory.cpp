@@ -1,10 +1,17 @@
 #include "SessionHistory.h"
+#include "HistoryStore.h"
 #include "Shared.h"
+#include "Persist.h"
 
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <memory>
 #include <vector>
+#include <list>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
@@ -12,18 +19,106 @@
 
 using json = nlohmann::json;
 
+// ── On-disk layout ─────────────────────────────────────────────────────────────
+//
+//   history-000000.lth, history-000001.lth, ...   sealed binary segments (HistoryStore)
+//   history.log                                   active log, one JSON line per session
+//
+// SaveSession() only queues the session; a writer thread does all file I/O.
+// It serializes each batch of queued sessions onto the log, which it rewrites
+// whole through a temp file and a rename, so a crash never leaves a torn
+// line.  The log holds at most LOG_SEAL_SESSIONS sessions, so a write costs
+// O(1) however long the history is.  Once the log is full the writer encodes
+// it into the next segment and deletes it.  Log lines carry their session's
+// ordinal ("seq"), so lines already sealed by a writer that died before
+// deleting the log are skipped on load.
+//
+// The older history.json (one pretty-printed array) is read when no binary
+// segment exists yet; the first compaction imports it as segment 0 and
+// renames it to history.json.bak.
+
+static const int    LOG_SEAL_SESSIONS = 32;
+static const size_t DECODED_SESSIONS  = 16; // LRU of sealed sessions decoded for the UI
+
 // ── Internal state ─────────────────────────────────────────────────────────────
-static std::mutex                     s_Mutex;
-static std::vector<SessionHistory::SavedSession> s_Sessions;
+
+// Where a session lives, not the session itself.  Sealed sessions are read
+// from their mapped segment when asked for; sessions still in JSON (the log
+// or history.json) keep their body in memory until a compaction seals them.
+// With neither, the session was in a segment that could not be read; it
+// keeps its ordinal so the ones after it keep theirs.
+struct StoredSession
+{
+    std::shared_ptr<const HistoryStore::Segment>        segment; // null until sealed
+    uint32_t                                            index = 0;
+    std::shared_ptr<const SessionHistory::SavedSession> body;    // null once sealed
+};
+
+using DecodedSession = std::pair<size_t, std::shared_ptr<const SessionHistory::SavedSession>>;
+
+static std::mutex                 s_Mutex;
+static std::vector<StoredSession> s_Sessions;      // by ordinal, oldest first
+static std::list<DecodedSession>  s_Decoded;       // most recently used first
+static std::atomic<uint64_t>      s_Version{ 1 }; // bumped on every change
+
+// File state.  Set by Load() before it starts the writer thread, then only
+// touched by that thread; nobody holds s_Mutex across file I/O.
+static int                      s_NextSegment    = 0; // first unused segment number
+static size_t                   s_LogFirst       = 0; // ordinal of the log's first session
+static int                      s_LogSessions    = 0; // sessions in history.log
+static std::string              s_LogText;            // history.log's contents
+static size_t                   s_LegacySessions = 0; // leading sessions still in history.json
+
+// ── Write-behind queue ─────────────────────────────────────────────────────────
+// SaveSession() queues the new session's ordinal.  The writer waits for the
+// queue to go quiet, so a burst of saves costs one log write.
+
+using Clock = std::chrono::steady_clock;
+
+static const auto WRITE_QUIET    = std::chrono::milliseconds(250); // batch window: idle gap
+static const auto WRITE_MAX_WAIT = std::chrono::seconds(1);        // ... capped at this
+
+static std::mutex              s_QueueMutex;
+static std::condition_variable s_QueueCv;
+static std::vector<size_t>     s_Queue;                  // ordinals not yet in the log
+static Clock::time_point       s_LastQueuedAt;
+static size_t                  s_MaxQueueDepth  = 0;
+static bool                    s_WriterStopping = false; // flush what's queued, then exit
+static std::thread             s_WriterThread;
+
+// Writer thread only; logged by Shutdown() after the join.
+struct WriterStats
+{
+    size_t batches  = 0;
+    size_t sessions = 0;
+    double totalMs  = 0.0;
+    double maxMs    = 0.0;
+};
+static WriterStats s_WriterStats;
 
 // ── Helpers ────────────────────────────────────────────────────────────────────
 
-static std::string HistoryPath()
+static std::string HistoryDir()
 {
     if (!APIDefs || !APIDefs->Paths_GetAddonDirectory) return "";
     std::string dir = APIDefs->Paths_GetAddonDirectory("LootTracker");
     CreateDirectoryA(dir.c_str(), nullptr);
-    return dir + "\\history.json";
+    return dir;
+}
+
+static std::string LegacyPath(const std::string& dir) { return dir + "\\history.json"; }
+static std::string LogPath(const std::string& dir)    { return dir + "\\history.log"; }
+
+static std::string SegmentPath(const std::string& dir, int n)
+{
+    char name[40];
+    snprintf(name, sizeof(name), "\\history-%06d.lth", n);
+    return dir + name;
+}
+
+static bool FileExists(const std::string& path)
+{
+    return std::ifstream(path).is_open();
 }
 
 static std::string ToISO8601(std::chrono::system_clock::time_point tp)
@@ -36,101 +131,310 @@ static std::string ToISO8601(std::chrono::system_clock::time_point tp)
     return ss.str();
 }
 
-static void Persist()
+// Running totals for the line Load() logs.
+struct LoadStats
 {
-    std::string path = HistoryPath();
-    if (path.empty()) return;
+    size_t rows      = 0;
+    size_t jsonBytes = 0; // JSON read (history.json and the log)
+};
 
-    json arr = json::array();
-    for (auto& s : s_Sessions)
+static StoredSession InMemory(SessionHistory::SavedSession s)
+{
+    return { nullptr, 0, std::make_shared<const SessionHistory::SavedSession>(std::move(s)) };
+}
+
+// A gap wider than this is a corrupt ordinal, not lost sessions.
+static const size_t MAX_ORDINAL_GAP = 1 << 16;
+
+// Pads out with unreadable placeholders up to ordinal.  False if ordinal is
+// already taken or implausibly far ahead.
+static bool PadTo(std::vector<StoredSession>& out, size_t ordinal)
+{
+    if (ordinal < out.size() || ordinal - out.size() > MAX_ORDINAL_GAP) return false;
+    out.resize(ordinal);
+    return true;
+}
+
+// Reads the log into out, skipping lines whose "seq" is below
+// firstSeq (already sealed) and lines that don't parse (torn by a crash in an
+// older version that appended in place).  Returns the number of sessions
+// read, or -1 if the file doesn't exist; kept collects the lines read.  The
+// first line read lands at its seq, after placeholders for any sessions lost
+// with an unreadable segment; *firstOrdinal is set to where it landed.
+static int ReadLines(const std::string& path, std::vector<StoredSession>& out,
+                     LoadStats& st, size_t firstSeq, std::string* kept, size_t* firstOrdinal)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) return -1;
+
+    int count = 0;
+    std::string line;
+    while (std::getline(f, line))
     {
-        json sess;
-        sess["label"]          = s.label;
-        sess["startTimestamp"] = s.startTimestamp;
-        sess["endTimestamp"]   = s.endTimestamp;
+        st.jsonBytes += line.size() + 1;
+        if (line.empty()) continue;
+        try
+        {
+            json j = json::parse(line);
+            size_t seq = j.value("seq", std::max(firstSeq, out.size()));
+            if (seq < firstSeq) continue;
+            if (count == 0)
+            {
+                PadTo(out, seq);
+                if (firstOrdinal) *firstOrdinal = out.size();
+            }
+            out.push_back(InMemory(HistoryStore::FromJson(j, st.rows)));
+            ++count;
+            if (kept) kept->append(line).push_back('\n');
+        }
+        catch (...) { /* torn or malformed line — skip it */ }
+    }
+    return count;
+}
+
+// ── Writer thread ──────────────────────────────────────────────────────────────
 
-        json items = json::array();
-        for (auto& item : s.items)
+// Encodes sessions [first, first + count) as the next segment, then serves
+// them from it and drops their in-memory bodies.
+static bool WriteSegment(const std::string& dir, size_t first, size_t count, size_t& bytes)
+{
+    // Hold the bodies so the encode doesn't hold s_Mutex.  These sessions came
+    // from JSON or SaveSession, so their bodies are in memory.
+    std::vector<std::shared_ptr<const SessionHistory::SavedSession>> bodies;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        for (size_t i = first; i < first + count && i < s_Sessions.size(); ++i)
         {
-            json j;
-            j["id"]          = item.id;
-            j["name"]        = item.name;
-            j["rarity"]      = item.rarity;
-            j["delta"]       = item.delta;
-            j["type"]        = item.type;
-            j["description"] = item.description;
-            j["vendorValue"] = item.vendorValue;
-            items.push_back(std::move(j));
+            if (!s_Sessions[i].body) return false;
+            bodies.push_back(s_Sessions[i].body);
         }
-        sess["items"] = std::move(items);
+    }
+    std::vector<const SessionHistory::SavedSession*> ptrs;
+    for (auto& b : bodies) ptrs.push_back(b.get());
+
+    std::string image = HistoryStore::Encode(ptrs, (uint32_t)first);
+    std::string path  = SegmentPath(dir, s_NextSegment);
+    if (!Persist::WriteFileAtomic(path, image)) return false;
+    ++s_NextSegment;
+    bytes = image.size();
+
+    if (auto seg = HistoryStore::Segment::Open(path))
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        for (uint32_t i = 0; i < seg->Size() && first + i < s_Sessions.size(); ++i)
+            s_Sessions[first + i] = { seg, i, nullptr };
+    }
+    return true;
+}
+
+static void Compact()
+{
+    std::string dir = HistoryDir();
+    if (dir.empty()) return;
 
-        json currencies = json::array();
-        for (auto& c : s.currencies)
+    auto t0 = Clock::now();
+
+    // history.json's sessions are the oldest, so they must become segment 0
+    // before the log is sealed behind them.
+    if (s_LegacySessions > 0)
+    {
+        size_t bytes = 0;
+        if (!WriteSegment(dir, 0, s_LegacySessions, bytes)) return;
+        const std::string legacyPath = LegacyPath(dir);
+        MoveFileExA(legacyPath.c_str(), (legacyPath + ".bak").c_str(), MOVEFILE_REPLACE_EXISTING);
+
+        if (APIDefs)
         {
-            json j;
-            j["id"]    = c.id;
-            j["name"]  = c.name;
-            j["delta"] = c.delta;
-            currencies.push_back(std::move(j));
+            char buf[160];
+            snprintf(buf, sizeof(buf), "History: imported %zu sessions from JSON into %zu KB in %.1f ms.",
+                     s_LegacySessions, bytes / 1024,
+                     std::chrono::duration<double, std::milli>(
+                         Clock::now() - t0).count());
+            APIDefs->Log(LOGL_INFO, "LootTracker", buf);
         }
-        sess["currencies"] = std::move(currencies);
+        s_LegacySessions = 0;
+    }
 
-        arr.push_back(std::move(sess));
+    if (s_LogSessions >= LOG_SEAL_SESSIONS)
+    {
+        size_t bytes = 0;
+        if (!WriteSegment(dir, s_LogFirst, (size_t)s_LogSessions, bytes)) return;
+        DeleteFileA(LogPath(dir).c_str());
+        s_LogFirst   += (size_t)s_LogSessions;
+        s_LogSessions = 0;
+        s_LogText.clear();
     }
+}
+
+// Appends the batch (consecutive ordinals) to the log.  The in-memory log
+// grows even if the write fails, so the next write retries these sessions.
+static void WriteBatch(const std::vector<size_t>& batch)
+{
+    auto t0 = Clock::now();
+
+    std::vector<std::shared_ptr<const SessionHistory::SavedSession>> bodies;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        for (size_t ordinal : batch)
+            bodies.push_back(ordinal < s_Sessions.size() ? s_Sessions[ordinal].body : nullptr);
+    }
+    for (size_t k = 0; k < batch.size(); ++k)
+    {
+        if (!bodies[k]) continue; // history was reloaded under it
+        json j = HistoryStore::ToJson(*bodies[k]);
+        j["seq"] = batch[k];
+        s_LogText += j.dump();
+        s_LogText += '\n';
+        if (s_LogSessions++ == 0) s_LogFirst = batch[k];
+    }
+
+    std::string dir = HistoryDir();
+    bool ok = !dir.empty() && Persist::WriteFileAtomic(LogPath(dir), s_LogText);
+
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    s_WriterStats.batches  += 1;
+    s_WriterStats.sessions += batch.size();
+    s_WriterStats.totalMs  += ms;
+    s_WriterStats.maxMs     = std::max(s_WriterStats.maxMs, ms);
+
+    if (APIDefs)
+    {
+        char buf[160];
+        snprintf(buf, sizeof(buf), ok
+            ? "History: wrote %zu queued sessions (log %zu KB) in %.2f ms."
+            : "History: writing %zu queued sessions (log %zu KB) failed after %.2f ms; will retry.",
+            batch.size(), s_LogText.size() / 1024, ms);
+        APIDefs->Log(ok ? LOGL_DEBUG : LOGL_WARNING, "LootTracker", buf);
+    }
+}
+
+static void WriterLoop()
+{
+    Compact(); // legacy import or a full log left by the last run
+
+    std::unique_lock<std::mutex> lock(s_QueueMutex);
+    for (;;)
+    {
+        s_QueueCv.wait(lock, [] { return s_WriterStopping || !s_Queue.empty(); });
+        if (s_Queue.empty()) break; // stopping with nothing left to flush
+
+        // Batching window; a flush cuts it short.
+        const Clock::time_point first = Clock::now();
+        while (!s_WriterStopping)
+        {
+            Clock::time_point until = std::min(s_LastQueuedAt + WRITE_QUIET,
+                                               first + WRITE_MAX_WAIT);
+            if (Clock::now() >= until) break;
+            s_QueueCv.wait_until(lock, until);
+        }
+
+        std::vector<size_t> batch;
+        batch.swap(s_Queue);
+        lock.unlock();
+
+        WriteBatch(batch);
+        Compact();
 
-    std::ofstream f(path);
-    if (f.is_open()) f << arr.dump(2);
+        lock.lock();
+    }
 }
 
 // ── Public API ─────────────────────────────────────────────────────────────────
 
 void SessionHistory::Load()
 {
-    std::string path = HistoryPath();
-    if (path.empty()) return;
+    std::string dir = HistoryDir();
+    if (dir.empty()) return;
+
+    auto t0 = Clock::now();
 
-    std::ifstream f(path);
-    if (!f.is_open()) return;
+    std::vector<StoredSession> sessions;
+    LoadStats st;
+    size_t segmentBytes = 0;
+    int    nextSegment  = 0;
 
-    try
+    // Binary segments: nothing is decoded until the UI asks for a page.
+    // Sessions sit at the ordinals their segment records, so one unreadable
+    // segment leaves a gap of placeholders instead of shifting everything
+    // after it (and out of step with the log's seq numbers).
+    for (;; ++nextSegment)
     {
-        json arr = json::parse(f);
-        std::lock_guard<std::mutex> lock(s_Mutex);
-        s_Sessions.clear();
+        std::string path = SegmentPath(dir, nextSegment);
+        if (!FileExists(path)) break;
+        auto seg = HistoryStore::Segment::Open(path);
+        if (!seg || !PadTo(sessions, seg->FirstOrdinal()))
+        {
+            if (APIDefs) APIDefs->Log(LOGL_WARNING, "LootTracker",
+                                      ("History: unreadable segment " + path).c_str());
+            continue;
+        }
+        segmentBytes += seg->FileBytes();
+        for (uint32_t i = 0; i < seg->Size(); ++i)
+            sessions.push_back({ seg, i, nullptr });
+    }
 
-        for (auto& sess : arr)
+    // history.json only counts while nothing has been imported; after a
+    // crash between the import and the rename it is already segment 0.
+    const std::string legacyPath = LegacyPath(dir);
+    if (FileExists(legacyPath) && nextSegment > 0)
+        MoveFileExA(legacyPath.c_str(), (legacyPath + ".bak").c_str(), MOVEFILE_REPLACE_EXISTING);
+    else if (FileExists(legacyPath))
+    {
+        std::ifstream f(legacyPath, std::ios::binary | std::ios::ate);
+        st.jsonBytes += (size_t)std::max<std::streamoff>(0, f.tellg());
+        f.seekg(0);
+        try
         {
-            SavedSession s;
-            s.label          = sess.value("label",          "");
-            s.startTimestamp = sess.value("startTimestamp", "");
-            s.endTimestamp   = sess.value("endTimestamp",   "");
+            json arr = json::parse(f);
+            for (auto& sess : arr)
+                sessions.push_back(InMemory(HistoryStore::FromJson(sess, st.rows)));
+        }
+        catch (...) { /* malformed JSON — start fresh */ }
+    }
+    const size_t legacy = nextSegment > 0 ? 0 : sessions.size(); // all from history.json
 
-            for (auto& jitem : sess.value("items", json::array()))
-            {
-                LootSession::ItemDelta d;
-                d.id          = jitem.value("id",          0);
-                d.name        = jitem.value("name",        "");
-                d.rarity      = jitem.value("rarity",      "");
-                d.delta       = jitem.value("delta",       0);
-                d.type        = jitem.value("type",        "");
-                d.description = jitem.value("description", "");
-                d.vendorValue = jitem.value("vendorValue", 0);
-                s.items.push_back(std::move(d));
-            }
+    // Only the lines that parsed are kept; the next write drops a torn one.
+    // Lines below the end of the last readable segment were sealed already.
+    // If the segments after it were lost, the log's first seq says where it
+    // starts.
+    size_t       logFirst = sessions.size();
+    std::string  logText;
+    int  logSessions = std::max(0, ReadLines(LogPath(dir), sessions, st, logFirst, &logText,
+                                             &logFirst));
+    const size_t total = sessions.size();
 
-            for (auto& jc : sess.value("currencies", json::array()))
-            {
-                LootSession::CurrencyDelta c;
-                c.id    = jc.value("id",    0);
-                c.name  = jc.value("name",  "");
-                c.delta = jc.value("delta", (int64_t)0);
-                s.currencies.push_back(std::move(c));
-            }
+    s_NextSegment    = nextSegment;
+    s_LogFirst       = logFirst;
+    s_LogSessions    = logSessions;
+    s_LogText        = std::move(logText);
+    s_LegacySessions = legacy;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Sessions = std::move(sessions);
+        s_Decoded.clear();
+        ++s_Version;
+    }
 
-            s_Sessions.push_back(std::move(s));
-        }
+    if (APIDefs)
+    {
+        double ms = std::chrono::duration<double, std::milli>(
+                        Clock::now() - t0).count();
+        char buf[256];
+        snprintf(buf, sizeof(buf),
+            "History: %zu sessions in %.1f ms (%d segments, %zu KB mapped; %zu KB JSON, %d in log, "
+            "%zu rows decoded).",
+            total, ms, nextSegment, segmentBytes / 1024, st.jsonBytes / 1024, logSessions,
+            st.rows);
+        APIDefs->Log(LOGL_INFO, "LootTracker", buf);
+    }
+
+    if (!s_WriterThread.joinable())
+    {
+        s_WriterStopping = false;
+        s_MaxQueueDepth  = 0;
+        s_WriterStats    = WriterStats();
+        s_WriterThread   = std::thread(WriterLoop);
     }
-    catch (...) { /* malformed JSON — start fresh */ }
 }
 
 void SessionHistory::SaveSession(
@@ -146,23 +450,156 @@ void SessionHistory::SaveSession(
         for (auto& c : currencies) if (c.delta != 0) { hasContent = true; break; }
     if (!hasContent) return;
 
+    size_t ordinal;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+
+        ordinal = s_Sessions.size();
+        SavedSession s;
+        s.label          = "Session " + std::to_string(ordinal + 1);
+        s.startTimestamp = ToISO8601(start);
+        s.endTimestamp   = ToISO8601(end);
+        s.items          = std::move(items);
+        s.currencies     = std::move(currencies);
+        s_Sessions.push_back(InMemory(std::move(s)));
+        ++s_Version;
+    }
+
+    // Serializing and writing happen on the writer thread.
+    {
+        std::lock_guard<std::mutex> lock(s_QueueMutex);
+        s_Queue.push_back(ordinal);
+        s_LastQueuedAt  = Clock::now();
+        s_MaxQueueDepth = std::max(s_MaxQueueDepth, s_Queue.size());
+    }
+    s_QueueCv.notify_one();
+}
+
+
+size_t SessionHistory::GetCount()
+{
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    return s_Sessions.size();
+}
+
+static size_t BodyBytes(const SessionHistory::SavedSession& s)
+{
+    return sizeof(s) + s.label.capacity() + s.startTimestamp.capacity() + s.endTimestamp.capacity()
+         + s.items.capacity() * sizeof(LootSession::ItemDelta)
+         + s.currencies.capacity() * sizeof(LootSession::CurrencyDelta);
+}
+
+SessionHistory::MemoryStats SessionHistory::GetMemoryStats()
+{
     std::lock_guard<std::mutex> lock(s_Mutex);
+    MemoryStats st;
+    st.sessions = s_Sessions.size();
+    const HistoryStore::Segment* last = nullptr;
+    for (auto& s : s_Sessions)
+    {
+        if (s.body)
+        {
+            ++st.bodies;
+            st.bodyBytes += BodyBytes(*s.body);
+        }
+        if (s.segment && s.segment.get() != last)
+        {
+            last = s.segment.get();
+            ++st.segments;
+            st.mappedBytes += last->FileBytes();
+        }
+    }
+    for (auto& [ordinal, body] : s_Decoded)
+    {
+        ++st.bodies;
+        st.bodyBytes += BodyBytes(*body);
+    }
+    st.bodyBytes += s_Sessions.capacity() * sizeof(StoredSession);
+    return st;
+}
 
-    SavedSession s;
-    s.label          = "Session " + std::to_string(s_Sessions.size() + 1);
-    s.startTimestamp = ToISO8601(start);
-    s.endTimestamp   = ToISO8601(end);
-    s.items          = std::move(items);
-    s.currencies     = std::move(currencies);
+std::vector<SessionHistory::SessionSummary> SessionHistory::GetSummaries(size_t skip, size_t count)
+{
+    // Copy the page's locations, then decode without holding s_Mutex.
+    std::vector<std::pair<size_t, StoredSession>> page;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        size_t n = s_Sessions.size();
+        for (size_t k = skip; k < n && k < skip + count; ++k) // newest first
+            page.emplace_back(n - 1 - k, s_Sessions[n - 1 - k]);
+    }
 
-    s_Sessions.push_back(std::move(s));
-    Persist();
+    std::vector<SessionSummary> out;
+    out.reserve(page.size());
+    for (auto& [ordinal, e] : page)
+    {
+        if (e.body)
+        {
+            out.push_back(Summarize(*e.body, ordinal));
+            continue;
+        }
+        SessionSummary sum;
+        sum.ordinal = ordinal;
+        if (!e.segment || !e.segment->DecodeSummary(e.index, sum))
+        {
+            sum = SessionSummary();
+            sum.ordinal = ordinal;
+            sum.label   = "Session " + std::to_string(ordinal + 1) + " (unreadable)";
+        }
+        out.push_back(std::move(sum));
+    }
+    return out;
 }
 
-std::vector<SessionHistory::SavedSession> SessionHistory::GetAll()
+std::shared_ptr<const SessionHistory::SavedSession> SessionHistory::GetSession(size_t ordinal)
 {
+    StoredSession e;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (ordinal >= s_Sessions.size()) return nullptr;
+        e = s_Sessions[ordinal];
+        if (e.body) return e.body;
+
+        for (auto it = s_Decoded.begin(); it != s_Decoded.end(); ++it)
+        {
+            if (it->first != ordinal) continue;
+            s_Decoded.splice(s_Decoded.begin(), s_Decoded, it);
+            return it->second;
+        }
+    }
+
+    auto decoded = std::make_shared<SavedSession>();
+    if (!e.segment || !e.segment->Decode(e.index, *decoded)) return nullptr;
+
     std::lock_guard<std::mutex> lock(s_Mutex);
-    auto copy = s_Sessions;
-    std::reverse(copy.begin(), copy.end()); // newest first
-    return copy;
+    s_Decoded.emplace_front(ordinal, decoded);
+    if (s_Decoded.size() > DECODED_SESSIONS) s_Decoded.pop_back();
+    return decoded;
+}
+
+uint64_t SessionHistory::GetVersion()
+{
+    return s_Version.load();
+}
+
+void SessionHistory::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_QueueMutex);
+        s_WriterStopping = true;
+    }
+    s_QueueCv.notify_all();
+    if (!s_WriterThread.joinable()) return;
+    s_WriterThread.join(); // flushes the queue and finishes a pending seal
+
+    if (APIDefs && s_WriterStats.batches > 0)
+    {
+        char buf[192];
+        snprintf(buf, sizeof(buf),
+            "History writer: %zu sessions in %zu writes (max queue depth %zu), "
+            "write latency avg %.2f ms, max %.2f ms.",
+            s_WriterStats.sessions, s_WriterStats.batches, s_MaxQueueDepth,
+            s_WriterStats.totalMs / s_WriterStats.batches, s_WriterStats.maxMs);
+        APIDefs->Log(LOGL_INFO, "LootTracker", buf);
+    }
 }
@@ -3,7 +3,9 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <chrono>
+#include <cstdint>
 
 namespace SessionHistory
 {
@@ -17,16 +19,65 @@ namespace SessionHistory
         std::vector<LootSession::CurrencyDelta> currencies;
     };
 
+    // ── What the history window shows for a collapsed session ─────────────────
+    // Kept in each segment's session header, so listing sessions never
+    // decodes their bodies.
+    constexpr size_t TOP_ITEMS = 3;
+
+    struct SessionSummary
+    {
+        size_t      ordinal = 0;        // position in the history, oldest = 0
+        std::string label;
+        std::string startTimestamp;
+        std::string endTimestamp;
+        int64_t     goldDelta     = 0;  // copper (currency 1)
+        uint32_t    itemCount     = 0;  // rows with a non-zero delta
+        uint32_t    currencyCount = 0;
+        std::vector<LootSession::ItemDelta> topItems; // largest gains first, up to TOP_ITEMS
+    };
+
+    // Builds s's summary (the header fields and the figures above).  Lives
+    // with the segment codec in HistoryStore.cpp, which stores it.
+    SessionSummary Summarize(const SavedSession& s, size_t ordinal);
+
     // Save the current finished session.  Called from Stop().
-    // start / end are wall-clock UTC times.
+    // start / end are wall-clock UTC times.  Only queues the session; the
+    // writer thread started by Load() writes it to disk.
     void SaveSession(std::chrono::system_clock::time_point start,
                      std::chrono::system_clock::time_point end,
                      std::vector<LootSession::ItemDelta>     items,
                      std::vector<LootSession::CurrencyDelta> currencies);
 
-    // Reload history from disk and return all sessions (newest first).
-    std::vector<SavedSession> GetAll();
+    // Number of saved sessions.
+    size_t GetCount();
+
+    // Summaries of up to count sessions, newest first, skipping the newest
+    // `skip`.  Costs O(count) whatever the history length.
+    std::vector<SessionSummary> GetSummaries(size_t skip, size_t count);
+
+    // The full session at ordinal, or null.  Sealed sessions are decoded on
+    // demand and kept in a small LRU, so holding the result is cheap.
+    std::shared_ptr<const SavedSession> GetSession(size_t ordinal);
+
+    // What the history keeps in memory, for the addon's memory report.
+    struct MemoryStats
+    {
+        size_t sessions    = 0;
+        size_t bodies      = 0; // sessions held decoded (unsealed, or in the LRU)
+        size_t bodyBytes   = 0; // their rows and strings
+        size_t segments    = 0;
+        size_t mappedBytes = 0; // segment files mapped (shared, not private memory)
+    };
+    MemoryStats GetMemoryStats();
+
+    // Increases whenever a session is saved or history is reloaded, so the
+    // UI only re-reads summaries when something changed.
+    uint64_t GetVersion();
 
     // Load history from disk (called once at addon init).
     void Load();
+
+    // Writes any queued sessions and stops the writer thread (called at
+    // addon unload).
+    void Shutdown();
 }
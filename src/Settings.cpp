@@ -1,14 +1,18 @@
 #include "Settings.h"
 #include "Shared.h"
+#include "Persist.h"
 
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <string>
+#include <atomic>
 
 using json = nlohmann::json;
 
 Settings g_Settings;
 
+static std::atomic<uint64_t> s_Version{ 1 };
+
 // Returns the full path to settings.json, e.g.
 // "C:\...\Guild Wars 2\addons\LootTracker\settings.json"
 static std::string SettingsPath()
@@ -25,6 +29,7 @@ static std::string SettingsPath()
 
 void Settings::Load()
 {
+    ++s_Version;
     std::string path = SettingsPath();
     if (path.empty()) return;
 
@@ -36,30 +41,52 @@ void Settings::Load()
         json j = json::parse(f);
         ApiKey          = j.value("ApiKey",           "");
         PollIntervalSec = j.value("PollIntervalSec",  30);
+        PollIntervalMinSec = j.value("PollIntervalMinSec", 10);
+        PollIntervalMaxSec = j.value("PollIntervalMaxSec", 300);
+        PollBudgetPerHour  = j.value("PollBudgetPerHour",  1800);
         ShowWindow      = j.value("ShowWindow",        true);
         ShowZeroDeltas  = j.value("ShowZeroDeltas",    false);
         TrackCurrency   = j.value("TrackCurrency",     true);
         TrackItems      = j.value("TrackItems",         true);
         AutoStart       = static_cast<AutoStartMode>(j.value("AutoStart", 0));
+        Transport       = static_cast<TransportMode>(j.value("Transport", 0));
+        TransportHost   = j.value("TransportHost",   "127.0.0.1");
+        TransportPort   = j.value("TransportPort",   8080);
+        ReplayDir       = j.value("ReplayDir",       "");
+        ReplayLatencyMs = j.value("ReplayLatencyMs", 0);
     }
     catch (...) { /* malformed json — ignore, use defaults */ }
 }
 
-void Settings::Save() const
+static std::string Serialize(const Settings& s)
 {
-    std::string path = SettingsPath();
-    if (path.empty()) return;
-
     json j;
-    j["ApiKey"]          = ApiKey;
-    j["PollIntervalSec"] = PollIntervalSec;
-    j["ShowWindow"]      = ShowWindow;
-    j["ShowZeroDeltas"]  = ShowZeroDeltas;
-    j["TrackCurrency"]   = TrackCurrency;
-    j["TrackItems"]      = TrackItems;
-    j["AutoStart"]       = static_cast<int>(AutoStart);
+    j["ApiKey"]          = s.ApiKey;
+    j["PollIntervalSec"] = s.PollIntervalSec;
+    j["PollIntervalMinSec"] = s.PollIntervalMinSec;
+    j["PollIntervalMaxSec"] = s.PollIntervalMaxSec;
+    j["PollBudgetPerHour"]  = s.PollBudgetPerHour;
+    j["ShowWindow"]      = s.ShowWindow;
+    j["ShowZeroDeltas"]  = s.ShowZeroDeltas;
+    j["TrackCurrency"]   = s.TrackCurrency;
+    j["TrackItems"]      = s.TrackItems;
+    j["AutoStart"]       = static_cast<int>(s.AutoStart);
+    j["Transport"]       = static_cast<int>(s.Transport);
+    j["TransportHost"]   = s.TransportHost;
+    j["TransportPort"]   = s.TransportPort;
+    j["ReplayDir"]       = s.ReplayDir;
+    j["ReplayLatencyMs"] = s.ReplayLatencyMs;
+    return j.dump(4);
+}
 
-    std::ofstream f(path);
-    if (f.is_open())
-        f << j.dump(4);
+void Settings::Save() const
+{
+    ++s_Version;
+    // The UI edits g_Settings in place, so the writer gets a copy.
+    Persist::Schedule("settings.json", [snapshot = *this] { return Serialize(snapshot); });
+}
+
+uint64_t Settings::Version() const
+{
+    return s_Version.load();
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <cstdint>
 
 // ── Auto-start modes ──────────────────────────────────────────────────────────
 enum class AutoStartMode
@@ -10,20 +11,47 @@ enum class AutoStartMode
     Daily    = 3,  // reset at GW2 daily reset (00:00 UTC)
 };
 
+// ── Network backend (developer option, settings.json only) ──────────────────
+enum class TransportMode
+{
+    WinHttp = 0,  // https://api.guildwars2.com (default)
+    Socket  = 1,  // plain HTTP to TransportHost:TransportPort (local mock / proxy)
+    Record  = 2,  // WinHTTP, and save every response to ReplayDir
+    Replay  = 3,  // serve saved responses from ReplayDir, no network
+};
+
 // ── Settings persisted to <addondir>/settings.json ───────────────────────────
 struct Settings
 {
     std::string   ApiKey;               // GW2 API key (requires "inventories + wallet")
-    int           PollIntervalSec = 30; // How often to query the GW2 API
+    int           PollIntervalSec    = 30;   // Base poll interval while playing
+    int           PollIntervalMinSec = 10;   // Fastest, while loot arrives every poll
+    int           PollIntervalMaxSec = 300;  // Slowest, while idle or out of game
+    int           PollBudgetPerHour  = 1800; // Hard cap on snapshot requests per hour (5 per poll
+                                             // at PollIntervalMinSec fits); item/currency
+                                             // lookups are paced by the scheduler instead
     bool          ShowWindow      = true;
     bool          ShowZeroDeltas  = false; // Include items with no change in the list
     bool          TrackCurrency   = true;
     bool          TrackItems      = true;
     AutoStartMode AutoStart       = AutoStartMode::Disabled;
 
+    // Not shown in the options UI — for profiling against recorded traffic.
+    TransportMode Transport       = TransportMode::WinHttp;
+    std::string   TransportHost   = "127.0.0.1";
+    int           TransportPort   = 8080;
+    std::string   ReplayDir;            // empty = <addondir>/replay
+    int           ReplayLatencyMs = 0;  // added to every replayed request
+
     // Load from / save to disk.  Path is resolved via APIDefs->Paths_GetAddonDirectory.
+    // Save() only schedules the write (see Persist), so it is cheap to call
+    // on every change.
     void Load();
     void Save() const;
+
+    // Increases on every Load()/Save().  Everything that changes a setting
+    // saves it, so this tells caches when to rebuild.
+    uint64_t Version() const;
 };
 
 extern Settings g_Settings;
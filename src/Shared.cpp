@@ -2,6 +2,3 @@
 
 AddonAPI_t*       APIDefs    = nullptr;
 HMODULE           Self       = nullptr;
-
-Mumble::LinkedMem* MumbleLink  = nullptr;
-Mumble::Identity*  MumbleIdent = nullptr;
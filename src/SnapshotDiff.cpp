@@ -0,0 +1,167 @@
+#include "SnapshotDiff.h"
+
+#include <algorithm>
+
+using namespace SnapshotDiff;
+
+// ── Normalisation ─────────────────────────────────────────────────────────────
+
+int64_t WalletColumns::ValueOf(int id) const
+{
+    if (id >= 0 && (size_t)id < values.size()) return values[id];
+    auto it = std::lower_bound(overflow.begin(), overflow.end(), id,
+        [](const std::pair<int, int64_t>& e, int v) { return e.first < v; });
+    return it != overflow.end() && it->first == id ? it->second : 0;
+}
+
+void SnapshotDiff::NormalizeItems(std::vector<GW2Api::ItemStack>& stacks, ItemColumns& out)
+{
+    std::sort(stacks.begin(), stacks.end(),
+              [](const GW2Api::ItemStack& a, const GW2Api::ItemStack& b) { return a.id < b.id; });
+    out.ids.clear();
+    out.counts.clear();
+    for (auto& st : stacks)
+    {
+        if (!out.ids.empty() && out.ids.back() == st.id)
+            out.counts.back() += st.count;
+        else
+        {
+            out.ids.push_back(st.id);
+            out.counts.push_back(st.count);
+        }
+    }
+}
+
+size_t SnapshotDiff::NormalizeWallet(const std::vector<GW2Api::WalletEntry>& wallet,
+                                     WalletColumns& out)
+{
+    // values is only read at listed IDs, so stale slots needn't be cleared.
+    out.ids.clear();
+    out.overflow.clear();
+    for (auto& w : wallet)
+    {
+        out.ids.push_back(w.id);
+        if (w.id < 0 || w.id > MAX_DENSE_CURRENCY_ID)
+        {
+            out.overflow.push_back({ w.id, w.value });
+            continue;
+        }
+        if ((size_t)w.id >= out.values.size()) out.values.resize(w.id + 1, 0);
+        out.values[w.id] = w.value;
+    }
+    std::sort(out.ids.begin(), out.ids.end());
+    std::sort(out.overflow.begin(), out.overflow.end());
+    return out.overflow.size();
+}
+
+// ── Item deltas ───────────────────────────────────────────────────────────────
+
+void SnapshotDiff::Rebase(ItemDeltas& d, const ItemColumns& base)
+{
+    d.ids  = base.ids;
+    d.base = base.counts;
+    d.delta.assign(base.ids.size(), 0);
+    d.shown.assign(base.ids.size(), 0);
+}
+
+void SnapshotDiff::Clear(ItemDeltas& d)
+{
+    d.ids.clear();
+    d.base.clear();
+    d.delta.clear();
+    d.shown.clear();
+}
+
+void SnapshotDiff::DiffItems(ItemDeltas& d, const ItemColumns& cur, std::vector<int>& newlyShown)
+{
+    auto set = [&](size_t i, int v)
+    {
+        d.delta[i] = v;
+        if (v != 0 && !d.shown[i]) { d.shown[i] = 1; newlyShown.push_back(d.ids[i]); }
+    };
+
+    // Rows and the snapshot are both sorted by ID: one pass covers items
+    // gained, changed and fully gone.  IDs with no row yet are set aside.
+    ItemColumns& added = d.added;
+    added.ids.clear();
+    added.counts.clear();
+    const size_t n = d.ids.size(), nc = cur.ids.size();
+    size_t i = 0, j = 0;
+    while (i < n && j < nc)
+    {
+        if      (d.ids[i] < cur.ids[j]) { set(i, -d.base[i]); ++i; }
+        else if (cur.ids[j] < d.ids[i])
+        {
+            added.ids.push_back(cur.ids[j]);
+            added.counts.push_back(cur.counts[j]);
+            ++j;
+        }
+        else { set(i, cur.counts[j] - d.base[i]); ++i; ++j; }
+    }
+    for (; i < n; ++i) set(i, -d.base[i]);
+    added.ids.insert(added.ids.end(), cur.ids.begin() + j, cur.ids.end());
+    added.counts.insert(added.counts.end(), cur.counts.begin() + j, cur.counts.end());
+    if (added.ids.empty()) return;
+
+    // Merge the new rows in from the back, so nothing moves twice.  Only the
+    // first poll an item shows up in pays for this.
+    const size_t k = added.ids.size();
+    d.ids.resize(n + k);
+    d.base.resize(n + k);
+    d.delta.resize(n + k);
+    d.shown.resize(n + k);
+    size_t p = n, q = k, w = n + k;
+    while (q > 0)
+    {
+        --w;
+        if (p > 0 && d.ids[p - 1] > added.ids[q - 1])
+        {
+            --p;
+            d.ids[w]   = d.ids[p];
+            d.base[w]  = d.base[p];
+            d.delta[w] = d.delta[p];
+            d.shown[w] = d.shown[p];
+        }
+        else
+        {
+            --q;
+            d.ids[w]   = added.ids[q];
+            d.base[w]  = 0;
+            d.delta[w] = 0;
+            d.shown[w] = 0;
+            set(w, added.counts[q]);
+        }
+    }
+}
+
+// ── Currency deltas ───────────────────────────────────────────────────────────
+
+void SnapshotDiff::DiffWallet(const WalletColumns& base, const WalletColumns& cur,
+                              CurrencyDeltas& out, std::vector<int>& added)
+{
+    out.ids.clear();
+    out.delta.clear();
+    auto put = [&](int id, int64_t v) { out.ids.push_back(id); out.delta.push_back(v); };
+
+    const size_t nb = base.ids.size(), nc = cur.ids.size();
+    size_t i = 0, j = 0;
+    while (i < nb || j < nc)
+    {
+        if (j == nc || (i < nb && base.ids[i] < cur.ids[j]))
+        {
+            put(base.ids[i], -base.ValueOf(base.ids[i]));
+            ++i;
+        }
+        else if (i == nb || cur.ids[j] < base.ids[i])
+        {
+            put(cur.ids[j], cur.ValueOf(cur.ids[j]));
+            added.push_back(cur.ids[j]);
+            ++j;
+        }
+        else
+        {
+            put(cur.ids[j], cur.ValueOf(cur.ids[j]) - base.ValueOf(base.ids[i]));
+            ++i; ++j;
+        }
+    }
+}
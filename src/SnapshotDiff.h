@@ -0,0 +1,73 @@
+#pragma once
+#include "GW2Api.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+// ── Snapshot normalisation and baseline diff ──────────────────────────────────
+// Items are parallel arrays sorted by ID, with stacks of the same item summed.
+// The session's item deltas are columns aligned with the same sorted IDs, so
+// diffing a poll is one linear merge.  Currency IDs are small and dense, so
+// wallet values are indexed by ID; an ID past MAX_DENSE_CURRENCY_ID goes to a
+// short sorted overflow list rather than sizing an array for it.
+//
+// Buffers keep their capacity from poll to poll; a steady-state diff
+// allocates nothing.  Nothing here locks; the caller serialises access.
+namespace SnapshotDiff
+{
+    static const int MAX_DENSE_CURRENCY_ID = 65535;
+
+    struct ItemColumns
+    {
+        std::vector<int> ids;
+        std::vector<int> counts;
+    };
+
+    struct WalletColumns
+    {
+        std::vector<int64_t>                   values;   // [currency id], up to MAX_DENSE_CURRENCY_ID
+        std::vector<int>                       ids;      // every listed ID, ascending
+        std::vector<std::pair<int, int64_t>>   overflow; // listed IDs outside values, ascending
+
+        // Value of a listed ID.
+        int64_t ValueOf(int id) const;
+    };
+
+    // Deltas since the baseline, one row per baseline ID and per ID seen since.
+    // A row is shown once its delta has been non-zero, and stays shown (at 0)
+    // if the count returns to its baseline.
+    struct ItemDeltas
+    {
+        std::vector<int>     ids;   // ascending
+        std::vector<int>     base;  // baseline count; 0 for IDs not in the baseline
+        std::vector<int>     delta;
+        std::vector<uint8_t> shown;
+        ItemColumns          added; // scratch: IDs new this poll
+    };
+
+    struct CurrencyDeltas
+    {
+        std::vector<int>     ids;   // baseline and latest wallet IDs, ascending
+        std::vector<int64_t> delta;
+    };
+
+    // Sorts stacks by ID and sums stacks of the same item into out.
+    void NormalizeItems(std::vector<GW2Api::ItemStack>& stacks, ItemColumns& out);
+
+    // Returns how many IDs went to the overflow list.
+    size_t NormalizeWallet(const std::vector<GW2Api::WalletEntry>& wallet, WalletColumns& out);
+
+    // Starts over from a baseline: every row at 0, none shown.
+    void Rebase(ItemDeltas& d, const ItemColumns& base);
+    void Clear(ItemDeltas& d);
+
+    // Updates d from the latest snapshot.  IDs whose row became shown are
+    // appended to newlyShown.
+    void DiffItems(ItemDeltas& d, const ItemColumns& cur, std::vector<int>& newlyShown);
+
+    // Rebuilds out from the baseline and latest wallets.  IDs in cur but not
+    // in base are appended to added.
+    void DiffWallet(const WalletColumns& base, const WalletColumns& cur,
+                    CurrencyDeltas& out, std::vector<int>& added);
+}
@@ -0,0 +1,390 @@
+#include "HttpTransport.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netdb.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+
+// ── Plain-socket HTTP/1.1 transport ───────────────────────────────────────────
+// Talks unencrypted HTTP to a local server (a mock, or a proxy in front of the
+// real API) so the request/parse/merge path can run off Windows.  Supports
+// keep-alive, Content-Length and chunked bodies, and the same Content-Encoding
+// handling as the WinHTTP backend.
+
+#ifdef _WIN32
+using Socket = SOCKET;
+static const Socket NO_SOCKET = INVALID_SOCKET;
+static void CloseSocket(Socket s) { closesocket(s); }
+static const int SEND_FLAGS = 0;
+#else
+using Socket = int;
+static const Socket NO_SOCKET = -1;
+static void CloseSocket(Socket s) { close(s); }
+static const int SEND_FLAGS = MSG_NOSIGNAL; // a dropped keep-alive socket must not raise SIGPIPE
+#endif
+
+// Idle keep-alive sockets kept per transport.
+static const size_t MAX_IDLE_SOCKETS = 8;
+
+// Receive timeout, so a stalled local server can't hang a poll forever.
+static const int RECV_TIMEOUT_MS = 30000;
+
+// Response headers larger than this are treated as a protocol error.
+static const size_t MAX_HEADER_BYTES = 64 * 1024;
+
+static bool HeaderIs(const std::string& name, const char* want)
+{
+    size_t n = strlen(want);
+    if (name.size() != n) return false;
+    for (size_t i = 0; i < n; ++i)
+        if (tolower((unsigned char)name[i]) != want[i]) return false;
+    return true;
+}
+
+static std::string Trim(const std::string& s)
+{
+    size_t b = s.find_first_not_of(" \t");
+    if (b == std::string::npos) return {};
+    size_t e = s.find_last_not_of(" \t\r");
+    return s.substr(b, e - b + 1);
+}
+
+namespace
+{
+    // Incremental "Transfer-Encoding: chunked" decoder.
+    struct ChunkedReader
+    {
+        enum class State { Size, Data, DataEnd, Trailer, Done };
+
+        State       state     = State::Size;
+        size_t      remaining = 0;
+        std::string line;
+
+        template <typename Emit>
+        bool Feed(const char* p, size_t n, Emit&& emit)
+        {
+            while (n > 0 && state != State::Done)
+            {
+                switch (state)
+                {
+                case State::Data:
+                {
+                    size_t take = std::min(n, remaining);
+                    emit(p, take);
+                    p += take; n -= take; remaining -= take;
+                    if (remaining == 0) state = State::DataEnd;
+                    break;
+                }
+                case State::DataEnd: // CRLF after the chunk data
+                    if (*p == '\n') state = State::Size;
+                    else if (*p != '\r') return false;
+                    ++p; --n;
+                    break;
+                case State::Size:
+                case State::Trailer:
+                    if (*p != '\n')
+                    {
+                        if (line.size() > 1024) return false;
+                        line += *p;
+                        ++p; --n;
+                        break;
+                    }
+                    ++p; --n;
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    if (state == State::Trailer)
+                    {
+                        if (line.empty()) state = State::Done;
+                    }
+                    else
+                    {
+                        char* end = nullptr;
+                        remaining = (size_t)strtoull(line.c_str(), &end, 16); // ignores ";ext"
+                        if (end == line.c_str()) return false;
+                        state = remaining ? State::Data : State::Trailer;
+                    }
+                    line.clear();
+                    break;
+                case State::Done:
+                    break;
+                }
+            }
+            return true;
+        }
+    };
+
+    class SocketTransport : public Http::ITransport
+    {
+    public:
+        SocketTransport(std::string host, int port)
+            : m_Host(std::move(host)), m_Port(port)
+        {
+#ifdef _WIN32
+            WSADATA wsa;
+            m_WsaStarted = WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+#endif
+        }
+
+        ~SocketTransport() override
+        {
+            Close();
+#ifdef _WIN32
+            if (m_WsaStarted) WSACleanup();
+#endif
+        }
+
+        bool Get(const Http::Request& req, Http::Response& out) override
+        {
+            // A pooled socket may have been closed by the server while idle.
+            // If nothing came back on it, retry once on a fresh connection.
+            Socket s      = Take();
+            bool   reused = s != NO_SOCKET;
+            if (!reused) s = Connect();
+            if (s == NO_SOCKET) return false;
+
+            bool received  = false;
+            bool keepAlive = false;
+            bool ok = Exchange(s, req, out, received, keepAlive);
+            if (!ok && reused && !received)
+            {
+                CloseSocket(s);
+                s = Connect();
+                if (s == NO_SOCKET) return false;
+                ok = Exchange(s, req, out, received, keepAlive);
+            }
+
+            if (ok && keepAlive) Put(s);
+            else                 CloseSocket(s);
+            return ok;
+        }
+
+        void Close() override
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (Socket s : m_Idle) CloseSocket(s);
+            m_Idle.clear();
+        }
+
+    private:
+        Socket Connect()
+        {
+            addrinfo hints{};
+            hints.ai_family   = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            addrinfo* res = nullptr;
+            if (getaddrinfo(m_Host.c_str(), std::to_string(m_Port).c_str(), &hints, &res) != 0)
+                return NO_SOCKET;
+
+            Socket s = NO_SOCKET;
+            for (addrinfo* ai = res; ai; ai = ai->ai_next)
+            {
+                s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+                if (s == NO_SOCKET) continue;
+                if (connect(s, ai->ai_addr, (int)ai->ai_addrlen) == 0) break;
+                CloseSocket(s);
+                s = NO_SOCKET;
+            }
+            freeaddrinfo(res);
+            if (s == NO_SOCKET) return NO_SOCKET;
+
+#ifdef _WIN32
+            DWORD timeout = RECV_TIMEOUT_MS;
+#else
+            timeval timeout{ RECV_TIMEOUT_MS / 1000, (RECV_TIMEOUT_MS % 1000) * 1000 };
+#endif
+            setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+            return s;
+        }
+
+        Socket Take()
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Idle.empty()) return NO_SOCKET;
+            Socket s = m_Idle.back();
+            m_Idle.pop_back();
+            return s;
+        }
+
+        void Put(Socket s)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Idle.size() < MAX_IDLE_SOCKETS) m_Idle.push_back(s);
+            else                                  CloseSocket(s);
+        }
+
+        static bool SendAll(Socket s, const std::string& data)
+        {
+            size_t sent = 0;
+            while (sent < data.size())
+            {
+                int n = send(s, data.data() + sent, (int)(data.size() - sent), SEND_FLAGS);
+                if (n <= 0) return false;
+                sent += (size_t)n;
+            }
+            return true;
+        }
+
+        bool Exchange(Socket s, const Http::Request& req, Http::Response& out,
+                      bool& received, bool& keepAlive)
+        {
+            out.status = 0;
+            out.body.clear();
+            out.etag.clear();
+            out.lastModified.clear();
+
+            // Paths are ASCII (character names arrive percent-encoded).
+            std::string request = "GET " + std::string(req.path.begin(), req.path.end()) +
+                " HTTP/1.1\r\nHost: " + m_Host + ":" + std::to_string(m_Port) +
+                "\r\nAccept-Encoding: gzip, deflate\r\nConnection: keep-alive\r\n";
+            if (!req.apiKey.empty())          request += "Authorization: Bearer " + req.apiKey + "\r\n";
+            if (!req.ifNoneMatch.empty())     request += "If-None-Match: " + req.ifNoneMatch + "\r\n";
+            if (!req.ifModifiedSince.empty()) request += "If-Modified-Since: " + req.ifModifiedSince + "\r\n";
+            request += "\r\n";
+            if (!SendAll(s, request)) return false;
+
+            // ── Status line + headers ─────────────────────────────────────────
+            char        buf[16 * 1024];
+            std::string head;
+            size_t      headerEnd = std::string::npos;
+            while (headerEnd == std::string::npos)
+            {
+                int n = recv(s, buf, sizeof(buf), 0);
+                if (n <= 0) return false;
+                received = true;
+                head.append(buf, (size_t)n);
+                headerEnd = head.find("\r\n\r\n");
+                if (headerEnd == std::string::npos && head.size() > MAX_HEADER_BYTES) return false;
+            }
+
+            std::string contentEncoding;
+            bool        chunked       = false;
+            bool        haveLength    = false;
+            size_t      contentLength = 0;
+            keepAlive = head.compare(0, 8, "HTTP/1.1") == 0;
+
+            size_t lineStart = 0;
+            while (lineStart < headerEnd)
+            {
+                size_t lineEnd = head.find("\r\n", lineStart);
+                std::string line = head.substr(lineStart, lineEnd - lineStart);
+                lineStart = lineEnd + 2;
+
+                if (out.status == 0)
+                {
+                    size_t sp = line.find(' ');
+                    if (line.compare(0, 5, "HTTP/") != 0 || sp == std::string::npos) return false;
+                    out.status = atoi(line.c_str() + sp + 1);
+                    continue;
+                }
+
+                size_t colon = line.find(':');
+                if (colon == std::string::npos) continue;
+                std::string name  = line.substr(0, colon);
+                std::string value = Trim(line.substr(colon + 1));
+
+                if      (HeaderIs(name, "etag"))             out.etag     = value;
+                else if (HeaderIs(name, "last-modified"))    out.lastModified = value;
+                else if (HeaderIs(name, "content-encoding")) contentEncoding = value;
+                else if (HeaderIs(name, "content-length"))
+                {
+                    contentLength = (size_t)strtoull(value.c_str(), nullptr, 10);
+                    haveLength    = true;
+                }
+                else if (HeaderIs(name, "transfer-encoding"))
+                    chunked = value.find("chunked") != std::string::npos;
+                else if (HeaderIs(name, "connection"))
+                    keepAlive = !HeaderIs(value, "close");
+            }
+            if (out.status == 0) return false;
+
+            // ── Body ──────────────────────────────────────────────────────────
+            bool noBody  = out.status == 204 || out.status == 304 || out.status < 200;
+            bool stream  = !req.raw && req.onData && out.status >= 200 && out.status < 300;
+            bool toArena = !req.raw && req.arena && !stream;
+            Http::BodyDecoder::Sink toBody = [&out, &req](const char* data, size_t len)
+            {
+                if (req.arena) req.arena->Append(data, len);
+                else           out.body.append(data, len);
+            };
+
+            Http::BodyDecoder  ownDecoder;
+            Http::BodyDecoder& decoder = req.arena ? req.arena->Decoder() : ownDecoder;
+            if (req.raw) out.contentEncoding = contentEncoding;
+            else         decoder.Begin(contentEncoding, stream ? req.onData : toBody);
+            if (toArena)
+            {
+                req.arena->Clear();
+                if (haveLength) req.arena->Reserve(contentLength);
+            }
+
+            bool          decoded = true;
+            ChunkedReader chunks;
+            size_t        bodyRead = 0;
+            auto write = [&](const char* data, size_t len)
+            {
+                if (req.raw)      out.body.append(data, len);
+                else if (decoded) decoded = decoder.Write(data, len);
+            };
+            // Returns false once the framing says the body is complete.
+            auto consume = [&](const char* data, size_t len) -> bool
+            {
+                if (chunked)
+                {
+                    if (!chunks.Feed(data, len, write)) { decoded = false; return false; }
+                    return chunks.state != ChunkedReader::State::Done;
+                }
+                if (haveLength) len = std::min(len, contentLength - bodyRead);
+                bodyRead += len;
+                write(data, len);
+                return !haveLength || bodyRead < contentLength;
+            };
+
+            bool more = !noBody && (chunked || !haveLength || contentLength > 0);
+            if (more && head.size() > headerEnd + 4)
+                more = consume(head.data() + headerEnd + 4, head.size() - headerEnd - 4);
+
+            while (more)
+            {
+                int n = recv(s, buf, sizeof(buf), 0);
+                if (n <= 0)
+                {
+                    // Without a length or chunking, the body runs to EOF.
+                    if (n < 0 || chunked || haveLength) decoded = false;
+                    keepAlive = false;
+                    break;
+                }
+                more = consume(buf, (size_t)n);
+            }
+            if (!haveLength && !chunked && !noBody) keepAlive = false;
+
+            // A body that can't be decoded is as good as no response.
+            return (req.raw || decoder.Finish()) && decoded;
+        }
+
+        const std::string m_Host;
+        const int         m_Port;
+#ifdef _WIN32
+        bool              m_WsaStarted = false;
+#endif
+
+        std::mutex          m_Mutex;
+        std::vector<Socket> m_Idle;
+    };
+}
+
+std::unique_ptr<Http::ITransport> Http::CreateSocketTransport(const std::string& host, int port)
+{
+    return std::make_unique<SocketTransport>(host, port);
+}
@@ -1,9 +1,11 @@
 #include "TrackingFilter.h"
 #include "Shared.h"
+#include "Persist.h"
 
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <mutex>
+#include <atomic>
 #include <windows.h>
 
 using json = nlohmann::json;
@@ -14,6 +16,7 @@ static std::mutex                   s_Mutex;
 static TrackingMode                 s_Mode   = TrackingMode::All;
 static int                          s_Active = -1;  // index into s_Profiles; -1 = none
 static std::vector<TrackingProfile> s_Profiles;
+static std::atomic<uint64_t>        s_Version{ 1 }; // bumped by every mutation
 
 // ── Helpers ────────────────────────────────────────────────────────────────────
 
@@ -36,6 +39,7 @@ TrackingMode TrackingFilter::GetMode()
 void TrackingFilter::SetMode(TrackingMode m)
 {
     std::lock_guard<std::mutex> lock(s_Mutex);
+    ++s_Version;
     s_Mode = m;
     if (m == TrackingMode::All) s_Active = -1;
 }
@@ -49,6 +53,7 @@ int TrackingFilter::GetActiveProfileIndex()
 void TrackingFilter::SetActiveProfile(int index)
 {
     std::lock_guard<std::mutex> lock(s_Mutex);
+    ++s_Version;
     // Clamp or clear
     if (index < 0 || index >= (int)s_Profiles.size())
     {
@@ -82,6 +87,11 @@ bool TrackingFilter::IsCurrencyTracked(int id)
     return ids.count(id) > 0;
 }
 
+uint64_t TrackingFilter::GetVersion()
+{
+    return s_Version.load();
+}
+
 std::vector<TrackingProfile> TrackingFilter::GetProfilesCopy()
 {
     std::lock_guard<std::mutex> lock(s_Mutex);
@@ -91,6 +101,7 @@ std::vector<TrackingProfile> TrackingFilter::GetProfilesCopy()
 int TrackingFilter::NewProfile(const std::string& name)
 {
     std::lock_guard<std::mutex> lock(s_Mutex);
+    ++s_Version;
     TrackingProfile p;
     p.name = name;
     s_Profiles.push_back(std::move(p));
@@ -103,6 +114,7 @@ int TrackingFilter::NewProfile(const std::string& name)
 void TrackingFilter::DeleteProfile(int index)
 {
     std::lock_guard<std::mutex> lock(s_Mutex);
+    ++s_Version;
     if (index < 0 || index >= (int)s_Profiles.size()) return;
     s_Profiles.erase(s_Profiles.begin() + index);
 
@@ -122,6 +134,7 @@ void TrackingFilter::DeleteProfile(int index)
 void TrackingFilter::UpdateProfile(int index, const TrackingProfile& p)
 {
     std::lock_guard<std::mutex> lock(s_Mutex);
+    ++s_Version;
     if (index < 0 || index >= (int)s_Profiles.size()) return;
     s_Profiles[index] = p;
 }
@@ -140,6 +153,7 @@ void TrackingFilter::Load()
     {
         json j = json::parse(f);
         std::lock_guard<std::mutex> lock(s_Mutex);
+        ++s_Version;
 
         s_Active = j.value("active", -1);
         s_Mode   = static_cast<TrackingMode>(j.value("mode", 0));
@@ -163,28 +177,36 @@ void TrackingFilter::Load()
 
 void TrackingFilter::Save()
 {
-    std::string path = ProfilesPath();
-    if (path.empty()) return;
-
-    std::lock_guard<std::mutex> lock(s_Mutex);
-
-    json j;
-    j["active"] = s_Active;
-    j["mode"]   = static_cast<int>(s_Mode);
-
-    json jprofiles = json::array();
-    for (auto& p : s_Profiles)
+    // Snapshot on the writer thread, so the lock the render thread takes per
+    // row is held only for the copy, never for the JSON or the disk.
+    Persist::Schedule("profiles.json", []
     {
-        json jp;
-        jp["name"] = p.name;
-        jp["itemIds"]     = json::array();
-        jp["currencyIds"] = json::array();
-        for (int id : p.itemIds)     jp["itemIds"].push_back(id);
-        for (int id : p.currencyIds) jp["currencyIds"].push_back(id);
-        jprofiles.push_back(std::move(jp));
-    }
-    j["profiles"] = std::move(jprofiles);
+        TrackingMode                 mode;
+        int                          active;
+        std::vector<TrackingProfile> profiles;
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            mode     = s_Mode;
+            active   = s_Active;
+            profiles = s_Profiles;
+        }
 
-    std::ofstream f(path);
-    if (f.is_open()) f << j.dump(2);
+        json j;
+        j["active"] = active;
+        j["mode"]   = static_cast<int>(mode);
+
+        json jprofiles = json::array();
+        for (auto& p : profiles)
+        {
+            json jp;
+            jp["name"] = p.name;
+            jp["itemIds"]     = json::array();
+            jp["currencyIds"] = json::array();
+            for (int id : p.itemIds)     jp["itemIds"].push_back(id);
+            for (int id : p.currencyIds) jp["currencyIds"].push_back(id);
+            jprofiles.push_back(std::move(jp));
+        }
+        j["profiles"] = std::move(jprofiles);
+        return j.dump(2);
+    });
 }
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <unordered_set>
+#include <cstdint>
 
 // ── Tracking modes ─────────────────────────────────────────────────────────────
 enum class TrackingMode { All = 0, Custom = 1 };
@@ -39,7 +40,11 @@ namespace TrackingFilter
     // Replaces the stored profile at index with p.
     void UpdateProfile(int index, const TrackingProfile& p);
 
+    // Increases whenever the mode, the active profile or any profile changes,
+    // so callers can cache what they derive from the filter.
+    uint64_t GetVersion();
+
     // ── Persistence ────────────────────────────────────────────────────────────
     void Load();
-    void Save();
+    void Save(); // schedules the write (see Persist); cheap to call per edit
 }
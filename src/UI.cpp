@@ -5,27 +5,36 @@
 #include "Shared.h"
 #include "SessionHistory.h"
 #include "TrackingFilter.h"
+#include "ItemSearch.h"
 
 #include <imgui.h>
 #include <string>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <memory>
+#include <unordered_map>
 
 // ── Helpers ───────────────────────────────────────────────────────────────────
 
-// GW2 rarity colour palette using IM_COL32(R, G, B, A).
-static ImU32 RarityColor(const std::string& rarity)
+// GW2 rarity colour palette using IM_COL32(R, G, B, A), indexed by Rarity.
+static const ImU32 RARITY_COLORS[] =
 {
-    if (rarity == "Junk")       return IM_COL32(170, 170, 170, 255); // grey
-    if (rarity == "Basic")      return IM_COL32(255, 255, 255, 255); // white
-    if (rarity == "Fine")       return IM_COL32(102, 153, 255, 255); // blue
-    if (rarity == "Masterwork") return IM_COL32( 26, 147,   6, 255); // green
-    if (rarity == "Rare")       return IM_COL32(250, 183,   0, 255); // gold
-    if (rarity == "Exotic")     return IM_COL32(200,  96,  10, 255); // orange
-    if (rarity == "Ascended")   return IM_COL32(251,  62, 141, 255); // pink
-    if (rarity == "Legendary")  return IM_COL32( 76,  19, 157, 255); // purple
-    return IM_COL32(255, 255, 255, 255);
+    IM_COL32(255, 255, 255, 255), // Unknown
+    IM_COL32(170, 170, 170, 255), // Junk       — grey
+    IM_COL32(255, 255, 255, 255), // Basic      — white
+    IM_COL32(102, 153, 255, 255), // Fine       — blue
+    IM_COL32( 26, 147,   6, 255), // Masterwork — green
+    IM_COL32(250, 183,   0, 255), // Rare       — gold
+    IM_COL32(200,  96,  10, 255), // Exotic     — orange
+    IM_COL32(251,  62, 141, 255), // Ascended   — pink
+    IM_COL32( 76,  19, 157, 255), // Legendary  — purple
+};
+static_assert(std::size(RARITY_COLORS) == (size_t)ItemEnums::Rarity::Count, "RARITY_COLORS out of sync");
+
+static ImU32 RarityColor(ItemEnums::Rarity rarity)
+{
+    return RARITY_COLORS[(size_t)rarity];
 }
 
 // Format a coin value (e.g. 123456 -> "12g 34s 56c").
@@ -59,11 +68,12 @@ static std::string FormatDuration(std::chrono::seconds dur)
 }
 
 // Try to get a texture's ID3D11ShaderResourceView* via Nexus — returns nullptr
-// if not loaded yet (icon will show as a coloured placeholder).
-static void* GetTexResource(const std::string& texId)
+// if not loaded yet (icon will show as a coloured placeholder).  texId must be
+// NUL-terminated (catalog strings are).
+static void* GetTexResource(std::string_view texId)
 {
     if (!APIDefs || texId.empty()) return nullptr;
-    Texture_t* t = APIDefs->Textures_Get(texId.c_str());
+    Texture_t* t = APIDefs->Textures_Get(texId.data());
     return (t && t->Resource) ? t->Resource : nullptr;
 }
 
@@ -78,6 +88,154 @@ static int             s_EditingProfileIdx    = -1;   // -1 = creating new
 static TrackingProfile s_WorkingProfile;
 static char            s_ProfileNameBuf[64] = {};
 
+// One line of the "Available items" list: a type header when item is null.
+struct AvailRow
+{
+    const LootSession::KnownItem* item;
+    std::string_view              type; // Catalog::TypeName; headers are labelled with it
+};
+
+// The "Available items" rows for one query and set of tracked items.
+struct AvailList
+{
+    uint64_t                searchVersion = ~0ull;
+    std::string             query;   // lowercased
+    std::unordered_set<int> tracked;
+    std::vector<AvailRow>   rows;
+};
+
+static AvailList s_AvailList;
+
+// ── Main window view model ────────────────────────────────────────────────────
+// The delta rows exactly as drawn: filtered by the active profile, with
+// placeholders for tracked IDs not seen yet and every label pre-formatted.
+// Rebuilt only when the published deltas, the tracking filter or the settings
+// change, so an ordinary frame just draws.
+
+struct CurrencyRow
+{
+    LootSession::CurrencyDelta delta;
+    std::string                label;   // "+1g 20s 0c  Coin##cur1"
+    std::string                popupId; // "LTCurRC1"
+};
+
+struct ItemRow
+{
+    LootSession::ItemDelta delta;
+    std::string            label;   // "Name##itm123"
+    std::string            tooltip; // "Exotic Weapon"
+    std::string            vendor;  // formatted vendor value; empty if none
+    std::string            popupId; // "LTItmRC123"
+};
+
+struct MainViewModel
+{
+    bool     built           = false;
+    uint64_t deltaVersion    = 0;
+    uint64_t filterVersion   = 0;
+    uint64_t settingsVersion = 0;
+
+    std::vector<TrackingProfile> profiles;  // for the profile bar and row popups
+    int                          activeIdx = -1;
+    std::vector<CurrencyRow>     currencies;
+    std::vector<ItemRow>         items;
+};
+
+static MainViewModel s_ViewModel;
+
+static void RefreshViewModel()
+{
+    // Versions first: a change made while rebuilding triggers another rebuild.
+    auto     view            = LootSession::GetDeltaView();
+    uint64_t filterVersion   = TrackingFilter::GetVersion();
+    uint64_t settingsVersion = g_Settings.Version();
+
+    MainViewModel& vm = s_ViewModel;
+    if (vm.built && vm.deltaVersion == view->version && vm.filterVersion == filterVersion &&
+        vm.settingsVersion == settingsVersion)
+        return;
+    vm.built           = true;
+    vm.deltaVersion    = view->version;
+    vm.filterVersion   = filterVersion;
+    vm.settingsVersion = settingsVersion;
+
+    vm.profiles  = TrackingFilter::GetProfilesCopy();
+    vm.activeIdx = TrackingFilter::GetActiveProfileIndex();
+    const bool custom = TrackingFilter::GetMode() == TrackingMode::Custom;
+
+    // When a profile is active, zero-delta placeholders stand in for tracked
+    // IDs not yet seen this session.
+    const TrackingProfile* active =
+        (custom && vm.activeIdx >= 0 && vm.activeIdx < (int)vm.profiles.size())
+        ? &vm.profiles[vm.activeIdx] : nullptr;
+
+    // ── Currencies ────────────────────────────────────────────────────────────
+    std::vector<LootSession::CurrencyDelta> currencies = view->currencies;
+    if (active)
+    {
+        std::unordered_set<int> present;
+        for (auto& c : currencies) present.insert(c.id);
+        for (int id : active->currencyIds)
+            if (!present.count(id))
+                currencies.push_back({ id, 0, Catalog::CurrencyFor(id) });
+    }
+
+    vm.currencies.clear();
+    for (auto& c : currencies)
+    {
+        if (!TrackingFilter::IsCurrencyTracked(c.id)) continue;
+
+        CurrencyRow row;
+        row.delta = c;
+        if (c.id == 1)
+            row.label = (c.delta >= 0 ? "+" : "") + FormatGold(c.delta) + "  "
+                      + std::string(c.info->name);
+        else
+        {
+            char buf[128];
+            snprintf(buf, sizeof(buf), "%+lld  %s", (long long)c.delta, c.info->name.data());
+            row.label = buf;
+        }
+        row.label  += "##cur" + std::to_string(c.id);
+        row.popupId = "LTCurRC" + std::to_string(c.id);
+        vm.currencies.push_back(std::move(row));
+    }
+
+    // ── Items ─────────────────────────────────────────────────────────────────
+    std::vector<LootSession::ItemDelta> items = view->items;
+    if (active)
+    {
+        std::unordered_set<int> present;
+        for (auto& d : items) present.insert(d.id);
+        for (int id : active->itemIds)
+            if (!present.count(id))
+                items.push_back({ id, 0, Catalog::ItemFor(id) });
+    }
+
+    vm.items.clear();
+    for (auto& item : items)
+    {
+        if (!TrackingFilter::IsItemTracked(item.id)) continue;
+        // Profile-pinned items always show, even at delta 0
+        if (!g_Settings.ShowZeroDeltas && item.delta == 0 && !custom) continue;
+
+        const Catalog::Item& info = *item.info;
+        ItemRow row;
+        row.delta = item;
+        row.label = std::string(info.name) + "##itm" + std::to_string(item.id);
+
+        const std::string_view rarity = Catalog::RarityName(info);
+        const std::string_view type   = Catalog::TypeName(info);
+        row.tooltip = std::string(rarity);
+        if (!rarity.empty() && !type.empty()) row.tooltip += " ";
+        row.tooltip += type;
+
+        if (info.vendorValue > 0) row.vendor = FormatGold(info.vendorValue);
+        row.popupId = "LTItmRC" + std::to_string(item.id);
+        vm.items.push_back(std::move(row));
+    }
+}
+
 void UI::Render()
 {
     if (!g_Settings.ShowWindow) return;
@@ -123,12 +281,20 @@ void UI::Render()
         GW2Api::PollNow();
     }
 
+    ImGui::SameLine();
+    {
+        GW2Api::PollSchedule ps = GW2Api::GetPollSchedule();
+        ImGui::TextDisabled("polling every %d s (%s)", ps.intervalSec, ps.reason);
+    }
+
     ImGui::Separator();
 
+    RefreshViewModel();
+
     // ── Profile bar ───────────────────────────────────────────────────────────
     {
-        auto profiles  = TrackingFilter::GetProfilesCopy();
-        int  activeIdx = TrackingFilter::GetActiveProfileIndex();
+        const auto& profiles  = s_ViewModel.profiles;
+        const int   activeIdx = s_ViewModel.activeIdx;
         const char* activeLabel = (activeIdx < 0 || activeIdx >= (int)profiles.size())
             ? "All" : profiles[activeIdx].name.c_str();
 
@@ -195,55 +361,18 @@ void UI::Render()
     {
         if (ImGui::CollapsingHeader("Currency", ImGuiTreeNodeFlags_DefaultOpen))
         {
-            auto currencies = LootSession::GetCurrencyDeltas();
-
-            // When a profile is active, inject zero-delta placeholders for
-            // tracked currencies not yet seen this session.
-            if (TrackingFilter::GetMode() == TrackingMode::Custom)
-            {
-                int activeIdx = TrackingFilter::GetActiveProfileIndex();
-                auto profiles = TrackingFilter::GetProfilesCopy();
-                if (activeIdx >= 0 && activeIdx < (int)profiles.size())
-                {
-                    std::unordered_set<int> present;
-                    for (auto& c : currencies) present.insert(c.id);
-
-                    auto knownCurs = LootSession::GetKnownCurrencies();
-                    std::unordered_map<int, LootSession::KnownCurrency> knownMap;
-                    for (auto& kc : knownCurs) knownMap[kc.id] = kc;
-
-                    for (int id : profiles[activeIdx].currencyIds)
-                    {
-                        if (present.count(id)) continue;
-                        LootSession::CurrencyDelta d;
-                        d.id        = id;
-                        d.delta     = 0;
-                        d.textureId = "LT_CURRENCY_" + std::to_string(id);
-                        auto it = knownMap.find(id);
-                        d.name = (it != knownMap.end()) ? it->second.name
-                                                        : "Currency #" + std::to_string(id);
-                        currencies.push_back(std::move(d));
-                    }
-                }
-            }
-
-            // Check whether anything will actually render
-            bool anyVisible = false;
-            for (auto& c : currencies)
-                if (TrackingFilter::IsCurrencyTracked(c.id)) { anyVisible = true; break; }
-
-            if (!anyVisible)
+            if (s_ViewModel.currencies.empty())
             {
                 ImGui::TextDisabled("No currency changes yet.");
             }
             else
             {
                 // Display each currency row
-                for (auto& c : currencies)
+                for (const CurrencyRow& row : s_ViewModel.currencies)
                 {
-                    if (!TrackingFilter::IsCurrencyTracked(c.id)) continue;
+                    const LootSession::CurrencyDelta& c = row.delta;
 
-                    void* icon = GetTexResource(c.textureId);
+                    void* icon = GetTexResource(c.info->textureId);
                     if (icon)
                     {
                         ImGui::Image((ImTextureID)icon, ImVec2(20, 20));
@@ -255,28 +384,15 @@ void UI::Render()
                         : ImVec4(1.0f, 0.4f, 0.4f, 1.0f); // red
 
                     // Selectable (instead of Text) so right-click popup attaches cleanly
-                    std::string dispText;
-                    if (c.id == 1)
-                        dispText = (c.delta >= 0 ? "+" : "") + FormatGold(c.delta) + "  " + c.name;
-                    else
-                    {
-                        char buf[128];
-                        snprintf(buf, sizeof(buf), "%+lld  %s", (long long)c.delta, c.name.c_str());
-                        dispText = buf;
-                    }
-                    std::string curSel = dispText + "##cur" + std::to_string(c.id);
                     ImGui::PushStyleColor(ImGuiCol_Text, col);
-                    ImGui::Selectable(curSel.c_str(), false, 0, ImVec2(0, 22));
+                    ImGui::Selectable(row.label.c_str(), false, 0, ImVec2(0, 22));
                     ImGui::PopStyleColor();
 
                     // Right-click: add / remove from profile
-                    char curCtxId[32];
-                    snprintf(curCtxId, sizeof(curCtxId), "LTCurRC%d", c.id);
-                    if (ImGui::BeginPopupContextItem(curCtxId))
+                    if (ImGui::BeginPopupContextItem(row.popupId.c_str()))
                     {
-                        auto profiles  = TrackingFilter::GetProfilesCopy();
-                        int  activeIdx = TrackingFilter::GetActiveProfileIndex();
-                        ImGui::TextDisabled("%s", c.name.c_str());
+                        const auto& profiles = s_ViewModel.profiles;
+                        ImGui::TextDisabled("%s", c.info->name.data());
                         ImGui::Separator();
                         if (!profiles.empty())
                         {
@@ -321,59 +437,7 @@ void UI::Render()
     {
         if (ImGui::CollapsingHeader("Items", ImGuiTreeNodeFlags_DefaultOpen))
         {
-            auto items = LootSession::GetItemDeltas();
-
-            // When a profile is active, inject zero-delta placeholders for
-            // tracked items not yet seen this session.
-            if (TrackingFilter::GetMode() == TrackingMode::Custom)
-            {
-                int activeIdx = TrackingFilter::GetActiveProfileIndex();
-                auto profiles = TrackingFilter::GetProfilesCopy();
-                if (activeIdx >= 0 && activeIdx < (int)profiles.size())
-                {
-                    std::unordered_set<int> present;
-                    for (auto& d : items) present.insert(d.id);
-
-                    auto knownItems = LootSession::GetKnownItems();
-                    std::unordered_map<int, LootSession::KnownItem> knownMap;
-                    for (auto& ki : knownItems) knownMap[ki.id] = ki;
-
-                    for (int id : profiles[activeIdx].itemIds)
-                    {
-                        if (present.count(id)) continue;
-                        LootSession::ItemDelta d;
-                        d.id        = id;
-                        d.delta     = 0;
-                        d.textureId = "LT_ITEM_" + std::to_string(id);
-                        auto it = knownMap.find(id);
-                        if (it != knownMap.end())
-                        {
-                            d.name   = it->second.name;
-                            d.rarity = it->second.rarity;
-                            d.type   = it->second.type;
-                        }
-                        else
-                        {
-                            d.name = "Item #" + std::to_string(id);
-                        }
-                        items.push_back(std::move(d));
-                    }
-                }
-            }
-
-            // Check whether anything will render (respecting filter + zero setting)
-            bool anyItemVisible = false;
-            for (auto& item : items)
-            {
-                if (!TrackingFilter::IsItemTracked(item.id)) continue;
-                // Profile-pinned items always show even at delta 0
-                bool pinned = (TrackingFilter::GetMode() == TrackingMode::Custom &&
-                               TrackingFilter::IsItemTracked(item.id));
-                if (!g_Settings.ShowZeroDeltas && item.delta == 0 && !pinned) continue;
-                anyItemVisible = true; break;
-            }
-
-            if (!anyItemVisible)
+            if (s_ViewModel.items.empty())
             {
                 ImGui::TextDisabled("No item changes yet.");
             }
@@ -392,118 +456,111 @@ void UI::Render()
                     ImGui::TableSetupColumn("Name",  ImGuiTableColumnFlags_WidthStretch);
                     ImGui::TableHeadersRow();
 
-                    for (auto& item : items)
+                    // Only the rows in view are submitted; the view model already holds
+                    // every label, so a long list costs no more than a short one.
+                    ImGuiListClipper clipper;
+                    clipper.Begin((int)s_ViewModel.items.size());
+                    while (clipper.Step())
                     {
-                        if (!TrackingFilter::IsItemTracked(item.id)) continue;
-
-                        // Profile-pinned items always show, even at delta 0
-                        bool pinned = (TrackingFilter::GetMode() == TrackingMode::Custom);
-                        if (!g_Settings.ShowZeroDeltas && item.delta == 0 && !pinned)
-                            continue;
-
-                        ImGui::TableNextRow();
-
-                        // Icon column
-                        ImGui::TableSetColumnIndex(0);
-                        void* icon = GetTexResource(item.textureId);
-                        if (icon)
-                            ImGui::Image((ImTextureID)icon, ImVec2(20, 20));
-                        else
+                        for (int ri = clipper.DisplayStart; ri < clipper.DisplayEnd; ++ri)
                         {
-                            // Colour placeholder square
-                            ImU32 col = RarityColor(item.rarity);
-                            ImGui::ColorButton("##sq",
-                                ImGui::ColorConvertU32ToFloat4(col),
-                                ImGuiColorEditFlags_NoTooltip |
-                                ImGuiColorEditFlags_NoBorder,
-                                ImVec2(20, 20));
-                        }
+                            const ItemRow&                row  = s_ViewModel.items[ri];
+                            const LootSession::ItemDelta& item = row.delta;
+                            const Catalog::Item&          info = *item.info;
+                            ImGui::TableNextRow();
+
+                            // Icon column
+                            ImGui::TableSetColumnIndex(0);
+                            void* icon = GetTexResource(info.textureId);
+                            if (icon)
+                                ImGui::Image((ImTextureID)icon, ImVec2(20, 20));
+                            else
+                            {
+                                // Colour placeholder square
+                                ImU32 col = RarityColor(info.rarity);
+                                ImGui::ColorButton("##sq",
+                                    ImGui::ColorConvertU32ToFloat4(col),
+                                    ImGuiColorEditFlags_NoTooltip |
+                                    ImGuiColorEditFlags_NoBorder,
+                                    ImVec2(20, 20));
+                            }
 
-                        // Count column
-                        ImGui::TableSetColumnIndex(1);
-                        ImVec4 countCol = item.delta >= 0
-                            ? ImVec4(0.4f, 1.0f, 0.4f, 1.0f)
-                            : ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
-                        ImGui::PushStyleColor(ImGuiCol_Text, countCol);
-                        ImGui::Text("%+d", item.delta);
-                        ImGui::PopStyleColor();
+                            // Count column
+                            ImGui::TableSetColumnIndex(1);
+                            ImVec4 countCol = item.delta >= 0
+                                ? ImVec4(0.4f, 1.0f, 0.4f, 1.0f)
+                                : ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
+                            ImGui::PushStyleColor(ImGuiCol_Text, countCol);
+                            ImGui::Text("%+d", item.delta);
+                            ImGui::PopStyleColor();
 
-                        // Name column — coloured by rarity, Selectable for right-click
-                        ImGui::TableSetColumnIndex(2);
-                        ImU32 rarityCol = RarityColor(item.rarity);
-                        ImGui::PushStyleColor(ImGuiCol_Text,
-                            ImGui::ColorConvertU32ToFloat4(rarityCol));
-                        std::string itmSel = item.name + "##itm" + std::to_string(item.id);
-                        ImGui::Selectable(itmSel.c_str(), false, 0, ImVec2(0, 20));
-                        ImGui::PopStyleColor();
+                            // Name column — coloured by rarity, Selectable for right-click
+                            ImGui::TableSetColumnIndex(2);
+                            ImU32 rarityCol = RarityColor(info.rarity);
+                            ImGui::PushStyleColor(ImGuiCol_Text,
+                                ImGui::ColorConvertU32ToFloat4(rarityCol));
+                            ImGui::Selectable(row.label.c_str(), false, 0, ImVec2(0, 20));
+                            ImGui::PopStyleColor();
 
-                        // Tooltip with item details (hover over name)
-                        if (ImGui::IsItemHovered())
-                        {
-                            ImGui::BeginTooltip();
-                            if (!item.type.empty() || !item.rarity.empty())
-                            {
-                                std::string hdr;
-                                if (!item.rarity.empty()) hdr = item.rarity;
-                                if (!item.rarity.empty() && !item.type.empty()) hdr += " ";
-                                if (!item.type.empty())   hdr += item.type;
-                                ImGui::TextDisabled("%s", hdr.c_str());
-                            }
-                            if (!item.description.empty())
+                            // Tooltip with item details (hover over name)
+                            if (ImGui::IsItemHovered())
                             {
-                                ImGui::PushTextWrapPos(ImGui::GetFontSize() * 16.0f);
-                                ImGui::TextUnformatted(item.description.c_str());
-                                ImGui::PopTextWrapPos();
-                            }
-                            if (item.vendorValue > 0)
-                            {
-                                ImGui::Separator();
-                                ImGui::Text("Vendor: %s", FormatGold(item.vendorValue).c_str());
+                                ImGui::BeginTooltip();
+                                if (!row.tooltip.empty())
+                                    ImGui::TextDisabled("%s", row.tooltip.c_str());
+                                if (!info.description.empty())
+                                {
+                                    ImGui::PushTextWrapPos(ImGui::GetFontSize() * 16.0f);
+                                    ImGui::TextUnformatted(info.description.data());
+                                    ImGui::PopTextWrapPos();
+                                }
+                                if (!row.vendor.empty())
+                                {
+                                    ImGui::Separator();
+                                    ImGui::Text("Vendor: %s", row.vendor.c_str());
+                                }
+                                ImGui::EndTooltip();
                             }
-                            ImGui::EndTooltip();
-                        }
 
-                        // Right-click: add / remove from profile
-                        char itmCtxId[32];
-                        snprintf(itmCtxId, sizeof(itmCtxId), "LTItmRC%d", item.id);
-                        if (ImGui::BeginPopupContextItem(itmCtxId))
-                        {
-                            auto profiles  = TrackingFilter::GetProfilesCopy();
-                            int  activeIdx = TrackingFilter::GetActiveProfileIndex();
-                            ImGui::TextDisabled("%s", item.name.c_str());
-                            ImGui::Separator();
-                            if (!profiles.empty())
+                            // Right-click: add / remove from profile
+                            if (ImGui::BeginPopupContextItem(row.popupId.c_str()))
                             {
-                                if (ImGui::BeginMenu("Add to profile"))
+                                const auto& profiles = s_ViewModel.profiles;
+                                ImGui::TextDisabled("%s", info.name.data());
+                                ImGui::Separator();
+                                if (!profiles.empty())
                                 {
-                                    for (int pi = 0; pi < (int)profiles.size(); pi++)
+                                    if (ImGui::BeginMenu("Add to profile"))
                                     {
-                                        bool already = profiles[pi].itemIds.count(item.id) > 0;
-                                        if (ImGui::MenuItem(profiles[pi].name.c_str(), nullptr, already))
+                                        for (int pi = 0; pi < (int)profiles.size(); pi++)
                                         {
-                                            auto p = profiles[pi];
-                                            if (already) p.itemIds.erase(item.id);
-                                            else         p.itemIds.insert(item.id);
-                                            TrackingFilter::UpdateProfile(pi, p);
-                                            TrackingFilter::Save();
+                                            bool already = profiles[pi].itemIds.count(item.id) > 0;
+                                            if (ImGui::MenuItem(profiles[pi].name.c_str(), nullptr, already))
+                                            {
+                                                auto p = profiles[pi];
+                                                if (already) p.itemIds.erase(item.id);
+                                                else         p.itemIds.insert(item.id);
+                                                TrackingFilter::UpdateProfile(pi, p);
+                                                TrackingFilter::Save();
+                                            }
                                         }
+                                        ImGui::EndMenu();
                                     }
-                                    ImGui::EndMenu();
                                 }
-                            }
-                            else
-                            {
-                                if (ImGui::MenuItem("Create first profile to track..."))
+                                else
                                 {
-                                    s_WorkingProfile = {};
-                                    s_WorkingProfile.itemIds.insert(item.id);
-                                    s_EditingProfileIdx = -1;
-                                    memset(s_ProfileNameBuf, 0, sizeof(s_ProfileNameBuf));
-                                    snprintf(s_ProfileNameBuf, sizeof(s_ProfileNameBuf), "New Profile");
-                                    s_ShowProfileEditor = true;
+                                    if (ImGui::MenuItem("Create first profile to track..."))
+                                    {
+                                        s_WorkingProfile = {};
+                                        s_WorkingProfile.itemIds.insert(item.id);
+                                        s_EditingProfileIdx = -1;
+                                        memset(s_ProfileNameBuf, 0, sizeof(s_ProfileNameBuf));
+                                        snprintf(s_ProfileNameBuf, sizeof(s_ProfileNameBuf), "New Profile");
+                                        s_ShowProfileEditor = true;
+                                    }
                                 }
+                                ImGui::EndPopup();
                             }
-                            ImGui::EndPopup();
                         }
                     }
                     ImGui::EndTable();
@@ -562,6 +619,35 @@ void UI::RenderOptions()
 
     ImGui::Spacing();
 
+    // Adaptive polling — sliders save once on release, not every drag frame
+    ImGui::TextUnformatted("Polling");
+    ImGui::SetNextItemWidth(-1.0f);
+    ImGui::SliderInt("##PollBase", &g_Settings.PollIntervalSec, 10, 300, "Normal: %d s");
+    if (ImGui::IsItemDeactivatedAfterEdit()) g_Settings.Save();
+    ImGui::SetNextItemWidth(-1.0f);
+    ImGui::SliderInt("##PollMin", &g_Settings.PollIntervalMinSec, 5, 120, "Fastest: %d s");
+    if (ImGui::IsItemDeactivatedAfterEdit()) g_Settings.Save();
+    ImGui::SetNextItemWidth(-1.0f);
+    ImGui::SliderInt("##PollMax", &g_Settings.PollIntervalMaxSec, 30, 900, "Slowest (AFK): %d s");
+    if (ImGui::IsItemDeactivatedAfterEdit()) g_Settings.Save();
+    ImGui::SetNextItemWidth(-1.0f);
+    ImGui::SliderInt("##PollBudget", &g_Settings.PollBudgetPerHour, 60, 3600, "Budget: %d snapshot requests/hour");
+    if (ImGui::IsItemDeactivatedAfterEdit()) g_Settings.Save();
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::BeginTooltip();
+        ImGui::TextUnformatted("Each poll costs 4-5 requests. Item and currency lookups\n"
+                               "are rate-limited separately and don't count here.");
+        ImGui::EndTooltip();
+    }
+    {
+        GW2Api::PollSchedule ps = GW2Api::GetPollSchedule();
+        ImGui::TextDisabled("Now every %d s (%s), %d snapshot requests in the last hour",
+                            ps.intervalSec, ps.reason, ps.requestsLastHour);
+    }
+
+    ImGui::Spacing();
+
     // Auto-start mode
     ImGui::TextUnformatted("Auto-start new session");
     static const char* s_AutoStartLabels[] = {
@@ -589,6 +675,127 @@ void UI::RenderOptions()
         s_ShowHistory = true;
 }
 
+// ── History window view model ─────────────────────────────────────────────────
+// One page of session summaries, plus the body of each expanded session with
+// the rows that pass the zero-delta setting.  The page is re-read only when
+// history, the settings or the page change; a body is fetched when its header
+// opens and dropped when it closes, so per-frame cost and memory don't grow
+// with the length of the history.
+
+static const size_t HISTORY_PAGE = 20;
+
+struct HistorySessionView
+{
+    SessionHistory::SessionSummary summary;
+    std::string                    header; // "Session 3  [start – end]##hist2"
+    std::string                    detail; // gold · item count · top items
+};
+
+struct ExpandedSession
+{
+    std::shared_ptr<const SessionHistory::SavedSession> session;
+    std::string                                         tableId;      // "LT_Hist_2"
+    std::vector<int>                                    visibleItems; // indices into session->items
+    uint64_t                                            settingsVersion = 0;
+};
+
+struct HistoryViewModel
+{
+    bool                            built           = false;
+    uint64_t                        historyVersion  = 0;
+    uint64_t                        settingsVersion = 0;
+    size_t                          page            = 0; // requested by the buttons
+    size_t                          loadedPage      = 0;
+    size_t                          count           = 0; // sessions in the whole history
+    std::vector<HistorySessionView> sessions;            // this page, newest first
+    std::unordered_map<size_t, ExpandedSession> expanded; // by ordinal
+};
+
+static HistoryViewModel s_HistoryView;
+
+static std::string HistoryDetail(const SessionHistory::SessionSummary& sum)
+{
+    std::string detail;
+    if (sum.goldDelta != 0)
+        detail = (sum.goldDelta > 0 ? "+" : "") + FormatGold(sum.goldDelta) + "  ·  ";
+    detail += std::to_string(sum.itemCount) + (sum.itemCount == 1 ? " item" : " items");
+    for (size_t i = 0; i < sum.topItems.size(); ++i)
+    {
+        detail += i == 0 ? "  ·  " : ", ";
+        detail += std::string(sum.topItems[i].info->name) + " +"
+                + std::to_string(sum.topItems[i].delta);
+    }
+    return detail;
+}
+
+static void RefreshHistoryViewModel()
+{
+    uint64_t historyVersion  = SessionHistory::GetVersion();
+    uint64_t settingsVersion = g_Settings.Version();
+
+    HistoryViewModel& vm = s_HistoryView;
+    if (vm.built && vm.historyVersion == historyVersion &&
+        vm.settingsVersion == settingsVersion && vm.loadedPage == vm.page)
+        return;
+    vm.built           = true;
+    vm.historyVersion  = historyVersion;
+    vm.settingsVersion = settingsVersion;
+
+    vm.count = SessionHistory::GetCount();
+    size_t lastPage = vm.count > 0 ? (vm.count - 1) / HISTORY_PAGE : 0;
+    vm.page       = std::min(vm.page, lastPage);
+    vm.loadedPage = vm.page;
+
+    vm.sessions.clear();
+    for (auto& sum : SessionHistory::GetSummaries(vm.page * HISTORY_PAGE, HISTORY_PAGE))
+    {
+        HistorySessionView hv;
+        hv.header  = sum.label + "  [" + sum.startTimestamp + " – " + sum.endTimestamp
+                   + "]##hist" + std::to_string(sum.ordinal);
+        hv.detail  = HistoryDetail(sum);
+        hv.summary = std::move(sum);
+        vm.sessions.push_back(std::move(hv));
+    }
+
+    // Keep only expanded sessions that are still on the page.
+    for (auto it = vm.expanded.begin(); it != vm.expanded.end();)
+    {
+        bool onPage = false;
+        for (auto& hv : vm.sessions)
+            if (hv.summary.ordinal == it->first) { onPage = true; break; }
+        it = onPage ? std::next(it) : vm.expanded.erase(it);
+    }
+}
+
+// Body of an expanded session, fetched on first use and re-filtered when the
+// settings change.  Null if the session can't be read.
+static const ExpandedSession* ExpandHistorySession(size_t ordinal)
+{
+    uint64_t settingsVersion = g_Settings.Version();
+
+    ExpandedSession& ex = s_HistoryView.expanded[ordinal];
+    if (!ex.session)
+    {
+        ex.session = SessionHistory::GetSession(ordinal);
+        if (!ex.session)
+        {
+            s_HistoryView.expanded.erase(ordinal);
+            return nullptr;
+        }
+        ex.tableId         = "LT_Hist_" + std::to_string(ordinal);
+        ex.settingsVersion = settingsVersion - 1; // force the filter below
+    }
+    if (ex.settingsVersion != settingsVersion)
+    {
+        ex.settingsVersion = settingsVersion;
+        ex.visibleItems.clear();
+        for (size_t i = 0; i < ex.session->items.size(); ++i)
+            if (g_Settings.ShowZeroDeltas || ex.session->items[i].delta != 0)
+                ex.visibleItems.push_back((int)i);
+    }
+    return &ex;
+}
+
 // ── History window ─────────────────────────────────────────────────────────────
 
 void UI::RenderHistory()
@@ -603,70 +810,103 @@ void UI::RenderHistory()
         return;
     }
 
-    auto sessions = SessionHistory::GetAll();
-    if (sessions.empty())
+    RefreshHistoryViewModel();
+    HistoryViewModel& vm = s_HistoryView;
+    if (vm.sessions.empty())
     {
         ImGui::TextDisabled("No completed sessions yet.");
         ImGui::End();
         return;
     }
 
-    for (size_t si = 0; si < sessions.size(); ++si)
+    // Page controls
+    size_t first = vm.page * HISTORY_PAGE;
+    ImGui::TextDisabled("Sessions %zu–%zu of %zu",
+        first + 1, first + vm.sessions.size(), vm.count);
+    if (vm.page > 0)
     {
-        auto& sess = sessions[si];
-        std::string header = sess.label + "  [" + sess.startTimestamp
-                             + " – " + sess.endTimestamp + "]";
+        ImGui::SameLine();
+        if (ImGui::SmallButton("< Newer")) --vm.page;
+    }
+    if (first + vm.sessions.size() < vm.count)
+    {
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Older >")) ++vm.page;
+    }
+    ImGui::Separator();
 
-        if (ImGui::CollapsingHeader(header.c_str()))
+    for (const HistorySessionView& hv : vm.sessions)
+    {
+        size_t ordinal = hv.summary.ordinal;
+        bool   open    = ImGui::CollapsingHeader(hv.header.c_str());
+        ImGui::TextDisabled("  %s", hv.detail.c_str());
+        if (!open)
         {
-            // Currency sub-section
-            if (!sess.currencies.empty())
+            vm.expanded.erase(ordinal);
+            continue;
+        }
+
+        const ExpandedSession* ex = ExpandHistorySession(ordinal);
+        if (!ex)
+        {
+            ImGui::TextDisabled("  This session could not be read.");
+            continue;
+        }
+        const SessionHistory::SavedSession& sess = *ex->session;
+
+        // Currency sub-section
+        if (!sess.currencies.empty())
+        {
+            ImGui::TextDisabled("Currency");
+            for (auto& c : sess.currencies)
             {
-                ImGui::TextDisabled("Currency");
-                for (auto& c : sess.currencies)
+                ImVec4 col = c.delta >= 0
+                    ? ImVec4(0.4f, 1.0f, 0.4f, 1.0f)
+                    : ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
+                ImGui::PushStyleColor(ImGuiCol_Text, col);
+                if (c.id == 1)
                 {
-                    ImVec4 col = c.delta >= 0
-                        ? ImVec4(0.4f, 1.0f, 0.4f, 1.0f)
-                        : ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
-                    ImGui::PushStyleColor(ImGuiCol_Text, col);
-                    if (c.id == 1)
-                    {
-                        std::string sign = c.delta >= 0 ? "+" : "";
-                        ImGui::Text("  %s%s  %s",
-                            sign.c_str(),
-                            FormatGold(c.delta).c_str(),
-                            c.name.c_str());
-                    }
-                    else
-                        ImGui::Text("  %+lld  %s", (long long)c.delta, c.name.c_str());
-                    ImGui::PopStyleColor();
+                    std::string sign = c.delta >= 0 ? "+" : "";
+                    ImGui::Text("  %s%s  %s",
+                        sign.c_str(),
+                        FormatGold(c.delta).c_str(),
+                        c.info->name.data());
                 }
+                else
+                    ImGui::Text("  %+lld  %s", (long long)c.delta, c.info->name.data());
+                ImGui::PopStyleColor();
             }
+        }
 
-            // Items sub-section
-            if (!sess.items.empty())
+        // Items sub-section
+        if (!ex->visibleItems.empty())
+        {
+            ImGui::Spacing();
+            ImGui::TextDisabled("Items");
+            if (ImGui::BeginTable(ex->tableId.c_str(), 3,
+                ImGuiTableFlags_ScrollY |
+                ImGuiTableFlags_RowBg   |
+                ImGuiTableFlags_BordersInnerV,
+                ImVec2(0, std::min((int)ex->visibleItems.size(), 10) * 22.0f + 22.0f)))
             {
-                ImGui::Spacing();
-                ImGui::TextDisabled("Items");
-                if (ImGui::BeginTable(("LT_Hist_" + std::to_string(si)).c_str(), 3,
-                    ImGuiTableFlags_ScrollY |
-                    ImGuiTableFlags_RowBg   |
-                    ImGuiTableFlags_BordersInnerV,
-                    ImVec2(0, std::min((int)sess.items.size(), 10) * 22.0f + 22.0f)))
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("",      ImGuiTableColumnFlags_WidthFixed,  24.0f);
+                ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed,  50.0f);
+                ImGui::TableSetupColumn("Name",  ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableHeadersRow();
+
+                ImGuiListClipper clipper;
+                clipper.Begin((int)ex->visibleItems.size());
+                while (clipper.Step())
                 {
-                    ImGui::TableSetupScrollFreeze(0, 1);
-                    ImGui::TableSetupColumn("",      ImGuiTableColumnFlags_WidthFixed,  24.0f);
-                    ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed,  50.0f);
-                    ImGui::TableSetupColumn("Name",  ImGuiTableColumnFlags_WidthStretch);
-                    ImGui::TableHeadersRow();
-
-                    for (auto& item : sess.items)
+                    for (int ri = clipper.DisplayStart; ri < clipper.DisplayEnd; ++ri)
                     {
-                        if (!g_Settings.ShowZeroDeltas && item.delta == 0) continue;
+                        const LootSession::ItemDelta& item = sess.items[ex->visibleItems[ri]];
+                        const Catalog::Item&          info = *item.info;
                         ImGui::TableNextRow();
 
                         ImGui::TableSetColumnIndex(0);
-                        void* icon = GetTexResource(item.textureId);
+                        void* icon = GetTexResource(info.textureId);
                         if (icon)
                             ImGui::Image((ImTextureID)icon, ImVec2(20, 20));
 
@@ -679,14 +919,14 @@ void UI::RenderHistory()
                         ImGui::PopStyleColor();
 
                         ImGui::TableSetColumnIndex(2);
-                        ImU32 rc = RarityColor(item.rarity);
+                        ImU32 rc = RarityColor(info.rarity);
                         ImGui::PushStyleColor(ImGuiCol_Text,
                             ImGui::ColorConvertU32ToFloat4(rc));
-                        ImGui::TextUnformatted(item.name.c_str());
+                        ImGui::TextUnformatted(info.name.data());
                         ImGui::PopStyleColor();
                     }
-                    ImGui::EndTable();
                 }
+                ImGui::EndTable();
             }
         }
     }
@@ -732,11 +972,12 @@ void UI::RenderProfileEditor()
                 ImGui::TextDisabled("No currencies seen yet — a poll will populate this list.");
 
             std::sort(curs.begin(), curs.end(),
-                [](const LootSession::KnownCurrency& a, const LootSession::KnownCurrency& b)
-                { return a.name < b.name; });
+                [](const LootSession::KnownCurrency* a, const LootSession::KnownCurrency* b)
+                { return a->name < b->name; });
 
-            for (auto& c : curs)
+            for (const LootSession::KnownCurrency* cp : curs)
             {
+                const LootSession::KnownCurrency& c = *cp;
                 bool tracked = s_WorkingProfile.currencyIds.count(c.id) > 0;
 
                 void* icon = GetTexResource(c.textureId);
@@ -744,7 +985,7 @@ void UI::RenderProfileEditor()
 
                 ImGui::PushStyleColor(ImGuiCol_Text,
                     tracked ? ImVec4(0.4f, 1.0f, 0.4f, 1.0f) : ImVec4(1, 1, 1, 0.9f));
-                std::string selLabel = c.name + "##ce_" + std::to_string(c.id);
+                std::string selLabel = std::string(c.name) + "##ce_" + std::to_string(c.id);
                 if (ImGui::Selectable(selLabel.c_str(), tracked, 0, ImVec2(0, 22)))
                 {
                     if (tracked) s_WorkingProfile.currencyIds.erase(c.id);
@@ -802,10 +1043,7 @@ void UI::RenderProfileEditor()
             ImGui::InputText("Search##PESearch", s_PESearch, sizeof(s_PESearch));
             ImGui::Spacing();
 
-            // Build lookup map of all known items
-            auto knownItems = LootSession::GetKnownItems();
-            std::unordered_map<int, const LootSession::KnownItem*> knownMap;
-            for (auto& ki : knownItems) knownMap[ki.id] = &ki;
+            ItemSearch::Sync();
 
             std::string searchLow = s_PESearch;
             for (auto& ch : searchLow) ch = (char)std::tolower((unsigned char)ch);
@@ -818,45 +1056,36 @@ void UI::RenderProfileEditor()
                 ImGui::PopStyleColor();
                 ImGui::Separator();
 
-                std::vector<std::pair<int,std::string>> tracked;
+                std::vector<const LootSession::KnownItem*> tracked;
                 for (int id : s_WorkingProfile.itemIds)
                 {
-                    auto it = knownMap.find(id);
-                    std::string nm = (it != knownMap.end())
-                        ? it->second->name : "Item #" + std::to_string(id);
+                    const LootSession::KnownItem* ki = Catalog::ItemFor(id);
                     if (!searchLow.empty())
                     {
-                        std::string nl = nm;
+                        std::string nl(ki->name);
                         for (auto& ch : nl) ch = (char)std::tolower((unsigned char)ch);
                         if (nl.find(searchLow) == std::string::npos) continue;
                     }
-                    tracked.push_back({id, nm});
+                    tracked.push_back(ki);
                 }
                 std::sort(tracked.begin(), tracked.end(),
-                    [](auto& a, auto& b){ return a.second < b.second; });
+                    [](auto* a, auto* b){ return a->name < b->name; });
 
-                for (auto& [id, nm] : tracked)
+                for (const LootSession::KnownItem* ki : tracked)
                 {
-                    auto it = knownMap.find(id);
-                    std::string rarity, texId;
-                    if (it != knownMap.end())
-                    {
-                        rarity = it->second->rarity;
-                        texId  = it->second->textureId;
-                    }
-
-                    void* icon = texId.empty() ? nullptr : GetTexResource(texId);
+                    const int id = ki->id;
+                    void* icon = GetTexResource(ki->textureId);
                     if (icon) { ImGui::Image((ImTextureID)icon, ImVec2(20, 20)); ImGui::SameLine(); }
-                    else if (!rarity.empty())
+                    else if (ki->rarity != ItemEnums::Rarity::Unknown)
                     {
                         ImGui::ColorButton("##pe_t",
-                            ImGui::ColorConvertU32ToFloat4(RarityColor(rarity)),
+                            ImGui::ColorConvertU32ToFloat4(RarityColor(ki->rarity)),
                             ImGuiColorEditFlags_NoTooltip | ImGuiColorEditFlags_NoBorder,
                             ImVec2(20, 20));
                         ImGui::SameLine();
                     }
                     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.4f, 1.0f, 0.4f, 1.0f));
-                    std::string lbl = nm + "##it_" + std::to_string(id);
+                    std::string lbl = std::string(ki->name) + "##it_" + std::to_string(id);
                     if (ImGui::Selectable(lbl.c_str(), true, 0, ImVec2(0, 22)))
                         s_WorkingProfile.itemIds.erase(id);
                     ImGui::PopStyleColor();
@@ -868,55 +1097,79 @@ void UI::RenderProfileEditor()
 
             // Section 2: available items (seen but not yet tracked)
             {
-                std::vector<const LootSession::KnownItem*> avail;
-                for (auto& ki : knownItems)
+                // Rows are rebuilt only when the index, the query or the
+                // profile's tracked items change; Find() narrows incrementally.
+                AvailList& al = s_AvailList;
+                if (al.searchVersion != ItemSearch::GetVersion() || al.query != searchLow ||
+                    al.tracked != s_WorkingProfile.itemIds)
                 {
-                    if (s_WorkingProfile.itemIds.count(ki.id)) continue;
-                    if (!searchLow.empty())
+                    al.searchVersion = ItemSearch::GetVersion();
+                    al.query         = searchLow;
+                    al.tracked       = s_WorkingProfile.itemIds;
+                    al.rows.clear();
+
+                    // Flatten into type-header and item rows of one height so the
+                    // clipper can skip straight to the rows in view.
+                    // Types the enum doesn't know each get their own header.
+                    bool first = true;
+                    std::string_view lastType;
+                    for (const LootSession::KnownItem* ki : ItemSearch::Find(searchLow))
                     {
-                        std::string nl = ki.name;
-                        for (auto& ch : nl) ch = (char)std::tolower((unsigned char)ch);
-                        if (nl.find(searchLow) == std::string::npos) continue;
+                        if (al.tracked.count(ki->id)) continue;
+                        std::string_view type = Catalog::TypeName(*ki);
+                        if (first || type != lastType)
+                            al.rows.push_back({ nullptr, type });
+                        al.rows.push_back({ ki, type });
+                        first    = false;
+                        lastType = type;
                     }
-                    avail.push_back(&ki);
                 }
-                if (!avail.empty())
+
+                if (!al.rows.empty())
                 {
-                    std::sort(avail.begin(), avail.end(),
-                        [](const LootSession::KnownItem* a, const LootSession::KnownItem* b)
-                        { return a->type == b->type ? a->name < b->name : a->type < b->type; });
+                    const std::vector<AvailRow>& rows = al.rows;
                     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 0.6f, 0.6f, 1.0f));
                     ImGui::TextUnformatted("Available items (seen this account)");
                     ImGui::PopStyleColor();
                     ImGui::Separator();
-                    std::string lastType;
-                    for (auto* item : avail)
+
+                    ImGuiListClipper clipper;
+                    clipper.Begin((int)rows.size());
+                    while (clipper.Step())
                     {
-                        if (item->type != lastType)
+                        for (int ri = clipper.DisplayStart; ri < clipper.DisplayEnd; ++ri)
                         {
-                            lastType = item->type;
-                            ImGui::Spacing();
-                            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.55f, 0.55f, 0.55f, 1.0f));
-                            ImGui::TextUnformatted(lastType.empty() ? "Unknown" : lastType.c_str());
+                            const AvailRow& row = rows[ri];
+                            if (!row.item)
+                            {
+                                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.55f, 0.55f, 0.55f, 1.0f));
+                                ImGui::PushID(ri);
+                                ImGui::Selectable(row.type.empty() ? "Unknown" : row.type.data(),
+                                                  false, ImGuiSelectableFlags_Disabled, ImVec2(0, 22));
+                                ImGui::PopID();
+                                ImGui::PopStyleColor();
+                                continue;
+                            }
+
+                            const LootSession::KnownItem* item = row.item;
+                            void* icon = GetTexResource(item->textureId);
+                            if (icon) { ImGui::Image((ImTextureID)icon, ImVec2(20, 20)); ImGui::SameLine(); }
+                            else
+                            {
+                                ImGui::ColorButton("##pe_sq",
+                                    ImGui::ColorConvertU32ToFloat4(RarityColor(item->rarity)),
+                                    ImGuiColorEditFlags_NoTooltip | ImGuiColorEditFlags_NoBorder,
+                                    ImVec2(20, 20));
+                                ImGui::SameLine();
+                            }
+                            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1, 1, 1, 0.85f));
+                            std::string lbl = std::string(item->name) + "##ie_" + std::to_string(item->id);
+                            if (ImGui::Selectable(lbl.c_str(), false, 0, ImVec2(0, 22)))
+                                s_WorkingProfile.itemIds.insert(item->id);
                             ImGui::PopStyleColor();
+                            if (ImGui::IsItemHovered())
+                            { ImGui::BeginTooltip(); ImGui::TextUnformatted("Click to add to profile"); ImGui::EndTooltip(); }
                         }
-                        void* icon = GetTexResource(item->textureId);
-                        if (icon) { ImGui::Image((ImTextureID)icon, ImVec2(20, 20)); ImGui::SameLine(); }
-                        else
-                        {
-                            ImGui::ColorButton("##pe_sq",
-                                ImGui::ColorConvertU32ToFloat4(RarityColor(item->rarity)),
-                                ImGuiColorEditFlags_NoTooltip | ImGuiColorEditFlags_NoBorder,
-                                ImVec2(20, 20));
-                            ImGui::SameLine();
-                        }
-                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1, 1, 1, 0.85f));
-                        std::string lbl = item->name + "##ie_" + std::to_string(item->id);
-                        if (ImGui::Selectable(lbl.c_str(), false, 0, ImVec2(0, 22)))
-                            s_WorkingProfile.itemIds.insert(item->id);
-                        ImGui::PopStyleColor();
-                        if (ImGui::IsItemHovered())
-                        { ImGui::BeginTooltip(); ImGui::TextUnformatted("Click to add to profile"); ImGui::EndTooltip(); }
                     }
                 }
                 else if (s_WorkingProfile.itemIds.empty())
@@ -5,6 +5,8 @@
 #include "UI.h"
 #include "SessionHistory.h"
 #include "TrackingFilter.h"
+#include "HttpTransport.h"
+#include "Persist.h"
 
 #include <imgui.h>
 #include <windows.h>
@@ -38,6 +40,39 @@ static void ProcessKeybind(const char* aIdentifier, bool aIsRelease)
     }
 }
 
+// ── Network backend ───────────────────────────────────────────────────────────
+// Installs the transport selected in settings.json.  Anything other than the
+// default is a developer option for profiling against recorded traffic.
+static void ConfigureTransport()
+{
+    std::string replayDir = g_Settings.ReplayDir;
+    if (replayDir.empty())
+        replayDir = std::string(APIDefs->Paths_GetAddonDirectory("LootTracker")) + "\\replay";
+
+    std::string desc;
+    switch (g_Settings.Transport)
+    {
+    case TransportMode::Socket:
+        Http::SetTransport(Http::CreateSocketTransport(g_Settings.TransportHost,
+                                                       g_Settings.TransportPort));
+        desc = "plain HTTP to " + g_Settings.TransportHost + ":" +
+               std::to_string(g_Settings.TransportPort);
+        break;
+    case TransportMode::Record:
+        Http::SetTransport(Http::CreateRecordingTransport(Http::GetTransport(), replayDir));
+        desc = "recording responses to " + replayDir;
+        break;
+    case TransportMode::Replay:
+        Http::SetTransport(Http::CreateReplayTransport(replayDir, g_Settings.ReplayLatencyMs));
+        desc = "replaying responses from " + replayDir + " (+" +
+               std::to_string(g_Settings.ReplayLatencyMs) + " ms)";
+        break;
+    default:
+        return; // WinHTTP, created lazily on first request
+    }
+    APIDefs->Log(LOGL_WARNING, "LootTracker", ("Network backend: " + desc).c_str());
+}
+
 // ── Addon lifecycle ───────────────────────────────────────────────────────────
 
 static void AddonLoad(AddonAPI_t* aApi)
@@ -59,6 +94,7 @@ static void AddonLoad(AddonAPI_t* aApi)
     // ── Load persisted settings ────────────────────────────────────────────────
     // Settings path requires APIDefs to be non-null (already set above).
     g_Settings.Load();
+    ConfigureTransport();
 
     // ── Load session history from disk ────────────────────────────────────────
     SessionHistory::Load();
@@ -101,7 +137,9 @@ static void AddonUnload()
     if (!APIDefs) return;
 
     // ── Stop background work first ────────────────────────────────────────────
-    LootSession::Shutdown(); // calls GW2Api::StopPolling() internally
+    LootSession::Shutdown();    // calls GW2Api::StopPolling() internally
+    Http::Shutdown();           // release pooled API connections
+    SessionHistory::Shutdown(); // flush queued history writes
 
     // ── Deregister everything we registered ───────────────────────────────────
     APIDefs->GUI_Deregister(UI::Render);
@@ -113,6 +151,7 @@ static void AddonUnload()
 
     // ── Persist final settings ────────────────────────────────────────────────
     g_Settings.Save();
+    Persist::Shutdown(); // write pending settings and profiles
 
     APIDefs->Log(LOGL_INFO, "LootTracker", "Loot Tracker unloaded.");
 
@@ -0,0 +1,110 @@
+#include "HttpTransport.h"
+#include "AllocCounter.h"
+#include "TestUtil.h"
+
+#include <zlib.h>
+#include <string>
+#include <algorithm>
+
+// BodyDecoder over gzip, zlib and raw deflate at several chunk sizes, its
+// failure modes, and a ResponseArena that reads the same body again without
+// allocating.
+
+static std::string Compress(const std::string& in, int windowBits)
+{
+    z_stream zs{};
+    deflateInit2(&zs, 6, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&zs, (uLong)in.size()), '\0');
+    zs.next_in   = (Bytef*)in.data();
+    zs.avail_in  = (uInt)in.size();
+    zs.next_out  = (Bytef*)&out[0];
+    zs.avail_out = (uInt)out.size();
+    deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+static bool Decode(Http::ResponseArena& arena, const char* encoding,
+                   const std::string& wire, size_t chunk)
+{
+    Http::BodyDecoder::Sink sink = [&arena](const char* p, size_t n) { arena.Append(p, n); };
+    arena.Clear();
+    Http::BodyDecoder& d = arena.Decoder();
+    d.Begin(encoding, sink);
+    bool ok = true;
+    for (size_t i = 0; i < wire.size(); i += chunk)
+        ok = d.Write(wire.data() + i, std::min(chunk, wire.size() - i)) && ok;
+    return d.Finish() && ok;
+}
+
+int main()
+{
+    std::string body;
+    for (int i = 0; i < 5000; ++i)
+        body += "{\"id\":" + std::to_string(i) + ",\"count\":250,\"binding\":\"Account\"},";
+
+    struct Case { const char* encoding; int windowBits; } cases[] = {
+        { "gzip", 15 + 16 }, { "deflate", 15 }, { "deflate", -15 }, { "", 0 }, { "identity", 0 },
+    };
+    Http::ResponseArena arena;
+    for (const Case& c : cases)
+    {
+        std::string wire = c.windowBits ? Compress(body, c.windowBits) : body;
+        for (size_t chunk : { (size_t)1, (size_t)7, (size_t)4096, (size_t)1 << 20 })
+        {
+            bool ok = Decode(arena, c.encoding, wire, chunk);
+            if (!ok || arena.View() != body)
+                fprintf(stderr, "%s/%d at %zu-byte chunks\n", c.encoding, c.windowBits, chunk);
+            CHECK(ok && arena.View() == body);
+        }
+    }
+
+    // Header values are matched case-insensitively, surrounding blanks ignored.
+    Http::BodyDecoder::Sink discard = [](const char*, size_t) {};
+    {
+        Http::BodyDecoder d;
+        d.Begin(" GZip ", discard);
+        CHECK(!d.IsIdentity());
+    }
+
+    // A truncated stream fails at Finish(); the decoder is usable afterwards.
+    const std::string gz = Compress(body, 15 + 16);
+    {
+        Http::BodyDecoder d;
+        d.Begin("gzip", discard);
+        d.Write(gz.data(), gz.size() / 2);
+        CHECK(!d.Finish());
+        d.Begin("gzip", discard);
+        CHECK(d.Write(gz.data(), gz.size()) && d.Finish());
+    }
+
+    // Corrupt data and unsupported encodings fail at Write().
+    {
+        Http::BodyDecoder d;
+        d.Begin("gzip", discard);
+        std::string bad = gz;
+        bad[gz.size() / 3] ^= 0x55;
+        bad[gz.size() / 3 + 1] ^= 0x55;
+        bool ok = d.Write(bad.data(), bad.size());
+        CHECK(!(ok && d.Finish()));
+
+        d.Begin("br", discard);
+        CHECK(!d.Write("x", 1));
+    }
+
+    // Steady state: the arena and inflate state are already sized, so the
+    // same body again allocates nothing.
+    CHECK(Decode(arena, "gzip", gz, 16 * 1024));
+    for (int round = 0; round < 3; ++round)
+    {
+        uint64_t a0 = AllocCounter::ThisThread();
+        bool ok = Decode(arena, "gzip", gz, 16 * 1024);
+        uint64_t allocs = AllocCounter::ThisThread() - a0;
+        CHECK(ok && arena.View() == body);
+        CHECK(!AllocCounter::Enabled() || allocs == 0);
+    }
+    CHECK(AllocCounter::Enabled());
+
+    return TestUtil::Result();
+}
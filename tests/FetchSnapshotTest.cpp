@@ -0,0 +1,158 @@
+#include "GW2Api.h"
+#include "HttpTransport.h"
+#include "MockApiServer.h"
+#include "TestUtil.h"
+
+#include <memory>
+
+// FetchSnapshot against the mock server over the socket transport: the five
+// requests are in flight at once, sections merge in order with their slot
+// markers, a failed item section is skipped and a failed wallet fails the
+// poll, 304s reuse the cached sections, and repeated 200 bodies are counted
+// by whether their parse was skipped.
+
+static const char* CHARACTER_PATH = "/v2/characters/Zo%C3%AB%20Ash/inventory";
+
+static void SetRoutes(MockApiServer& server, int delayMs, bool etags)
+{
+    auto route = [&](const char* path, const char* body, const char* etag)
+    {
+        MockApiServer::Route r;
+        r.body    = body;
+        r.etag    = etags ? etag : "";
+        r.delayMs = delayMs;
+        server.SetRoute(path, r);
+    };
+    route("/v2/account/wallet", R"([{"id":1,"value":12345},{"id":4,"value":20}])", "\"w1\"");
+    route(CHARACTER_PATH,
+          R"({"bags":[{"id":8932,"size":3,"inventory":[null,{"id":100,"count":2},{"id":200,"count":1}]}]})",
+          "\"c1\"");
+    route("/v2/account/materials", R"([{"id":100,"count":5,"category":5},{"id":300,"count":250,"category":5}])",
+          "\"m1\"");
+    route("/v2/account/bank", R"([{"id":200,"count":3},null,{"id":400,"count":1}])", "\"b1\"");
+    route("/v2/account/inventory", R"([null,{"id":500,"count":7}])", "\"s1\"");
+}
+
+static const GW2Api::ItemStack* Find(const GW2Api::Snapshot& snap, int id)
+{
+    for (auto& st : snap.inventory)
+        if (st.id == id) return &st;
+    return nullptr;
+}
+
+static void TestConcurrentMerge(MockApiServer& server)
+{
+    SetRoutes(server, 100, false);
+    server.ResetStats();
+
+    GW2Api::Snapshot snap;
+    CHECK(GW2Api::FetchSnapshot("key-merge", "Zo\xC3\xAB Ash", snap));
+    GW2Api::PollTiming t = GW2Api::GetLastPollTiming();
+
+    CHECK(server.Requests() == 5);
+    CHECK(server.MaxInFlight() == 5);
+    CHECK(t.totalMs < 0.6 * t.serialMs); // ~100 ms against ~500 ms
+    printf("concurrent poll: %.0f ms end to end, %.0f ms sequentially\n", t.totalMs, t.serialMs);
+
+    CHECK(snap.wallet.size() == 2 && snap.wallet[0].id == 1 && snap.wallet[0].value == 12345);
+
+    // One stack per ID, in source order, keeping the first source's slot.
+    CHECK(snap.inventory.size() == 5);
+    const int ids[]    = { 100, 200, 300, 400, 500 };
+    const int counts[] = { 7, 4, 250, 1, 7 };
+    const int slots[]  = { 1, 2, -1, -2, -3 };
+    for (size_t i = 0; i < 5 && i < snap.inventory.size(); ++i)
+    {
+        CHECK(snap.inventory[i].id == ids[i]);
+        CHECK(snap.inventory[i].count == counts[i]);
+        CHECK(snap.inventory[i].slot == slots[i]);
+    }
+}
+
+static void TestWithoutCharacter(MockApiServer& server)
+{
+    SetRoutes(server, 0, false);
+    server.ResetStats();
+
+    GW2Api::Snapshot snap;
+    CHECK(GW2Api::FetchSnapshot("key-nochar", "", snap));
+    CHECK(server.Requests() == 4);
+    const GW2Api::ItemStack* mat = Find(snap, 100);
+    CHECK(mat && mat->count == 5 && mat->slot == -1);
+    CHECK(GW2Api::GetLastPollTiming().characterMs == 0.0);
+}
+
+static void TestPartialFailure(MockApiServer& server)
+{
+    SetRoutes(server, 0, false);
+    MockApiServer::Route broken;
+    broken.status = 500;
+    server.SetRoute("/v2/account/bank", broken);
+
+    GW2Api::Snapshot snap;
+    CHECK(GW2Api::FetchSnapshot("key-partial", "Zo\xC3\xAB Ash", snap));
+    CHECK(!Find(snap, 400));                          // bank skipped
+    CHECK(Find(snap, 200) && Find(snap, 200)->count == 1);
+    CHECK(Find(snap, 500) && Find(snap, 500)->slot == -3);
+
+    server.SetRoute("/v2/account/wallet", broken);
+    CHECK(!GW2Api::FetchSnapshot("key-partial", "Zo\xC3\xAB Ash", snap));
+}
+
+static void TestNotModified(MockApiServer& server)
+{
+    SetRoutes(server, 0, true);
+
+    GW2Api::Snapshot first, second;
+    CHECK(GW2Api::FetchSnapshot("key-etag", "Zo\xC3\xAB Ash", first));
+    GW2Api::CacheStats before = GW2Api::GetCacheStats();
+    CHECK(GW2Api::FetchSnapshot("key-etag", "Zo\xC3\xAB Ash", second));
+    GW2Api::CacheStats after = GW2Api::GetCacheStats();
+
+    CHECK(after.notModified - before.notModified == 5);
+    CHECK(after.fullParses == before.fullParses);
+    CHECK(second.wallet.size() == first.wallet.size());
+    CHECK(second.inventory.size() == first.inventory.size());
+    for (size_t i = 0; i < first.inventory.size() && i < second.inventory.size(); ++i)
+        CHECK(second.inventory[i].id == first.inventory[i].id &&
+              second.inventory[i].count == first.inventory[i].count &&
+              second.inventory[i].slot == first.inventory[i].slot);
+}
+
+// Without validators every body comes back as a 200.  Only the wallet's is
+// buffered, so only it skips its parse; the streamed item bodies were parsed
+// on the way in and count as parses.
+static void TestIdenticalBodies(MockApiServer& server)
+{
+    SetRoutes(server, 0, false);
+
+    GW2Api::Snapshot first, second;
+    CHECK(GW2Api::FetchSnapshot("key-identical", "Zo\xC3\xAB Ash", first));
+    GW2Api::CacheStats before = GW2Api::GetCacheStats();
+    CHECK(GW2Api::FetchSnapshot("key-identical", "Zo\xC3\xAB Ash", second));
+    GW2Api::CacheStats after = GW2Api::GetCacheStats();
+
+    CHECK(after.notModified == before.notModified);
+    CHECK(after.identicalBodies - before.identicalBodies == 1);
+    CHECK(after.fullParses - before.fullParses == 4);
+    CHECK(second.inventory.size() == first.inventory.size());
+}
+
+int main()
+{
+    {
+        MockApiServer server;
+        Http::SetTransport(std::shared_ptr<Http::ITransport>(
+            Http::CreateSocketTransport("127.0.0.1", server.Port())));
+
+        TestConcurrentMerge(server);
+        TestWithoutCharacter(server);
+        TestPartialFailure(server);
+        TestNotModified(server);
+        TestIdenticalBodies(server);
+
+        GW2Api::StopPolling();
+        Http::Shutdown();
+    }
+    return TestUtil::Result();
+}
@@ -0,0 +1,115 @@
+#include "HistoryStore.h"
+#include "TestUtil.h"
+
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+// A synthetic history (10,000 sessions, ~43 item rows each, drawn from a
+// few thousand items) as a pretty-printed history.json and as one binary
+// segment: file sizes, the JSON load the addon used to do, and the segment's
+// encode, open and full decode.
+//
+//   HistoryStoreBench [sessions]
+
+using json = nlohmann::json;
+
+static const char* RARITIES[] = { "Junk", "Basic", "Fine", "Masterwork", "Rare", "Exotic", "Ascended" };
+static const char* TYPES[]    = { "CraftingMaterial", "Trophy", "Consumable", "Container", "Armor", "Weapon" };
+
+static json SyntheticHistory(int sessions)
+{
+    std::mt19937 rng(1);
+    json arr = json::array();
+    for (int n = 0; n < sessions; ++n)
+    {
+        json sess;
+        sess["label"]          = "Session " + std::to_string(n + 1);
+        sess["startTimestamp"] = "2025-04-07T12:00:00Z";
+        sess["endTimestamp"]   = "2025-04-07T13:00:00Z";
+
+        json items = json::array();
+        int rows = 30 + int(rng() % 27);
+        for (int i = 0; i < rows; ++i)
+        {
+            int id = 1000 + int(rng() % 4000);
+            json j;
+            j["id"]          = id;
+            j["name"]        = "Item number " + std::to_string(id);
+            j["rarity"]      = RARITIES[id % 7];
+            j["delta"]       = int(rng() % 400) - 100;
+            j["type"]        = TYPES[id % 6];
+            j["description"] = id % 3 ? "" : "Flavour text for item " + std::to_string(id) + ".";
+            j["vendorValue"] = id % 200;
+            items.push_back(std::move(j));
+        }
+        sess["items"] = std::move(items);
+
+        json currencies = json::array();
+        for (int id = 1; id <= 3; ++id)
+            currencies.push_back({ { "id", id }, { "name", "Currency " + std::to_string(id) },
+                                   { "delta", int64_t(rng() % 100000) - 20000 } });
+        sess["currencies"] = std::move(currencies);
+        arr.push_back(std::move(sess));
+    }
+    return arr;
+}
+
+int main(int argc, char** argv)
+{
+    const int sessionCount = argc > 1 ? std::max(1, atoi(argv[1])) : 10000;
+    const std::string text = SyntheticHistory(sessionCount).dump(4);
+
+    // history.json as Load() read it: parse, then import every session.
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<SessionHistory::SavedSession> sessions;
+    size_t rows = 0;
+    for (auto& sess : json::parse(text)) sessions.push_back(HistoryStore::FromJson(sess, rows));
+    double jsonMs = TestUtil::MsSince(t0);
+
+    std::vector<const SessionHistory::SavedSession*> ptrs;
+    for (auto& s : sessions) ptrs.push_back(&s);
+    t0 = std::chrono::steady_clock::now();
+    std::string image = HistoryStore::Encode(ptrs, 0);
+    double encodeMs = TestUtil::MsSince(t0);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "loottracker-bench.lth").string();
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write(image.data(), (std::streamsize)image.size());
+    }
+
+    // Open is what Load() pays per segment; listing a page reads summaries.
+    t0 = std::chrono::steady_clock::now();
+    auto seg = HistoryStore::Segment::Open(path);
+    double openMs = TestUtil::MsSince(t0);
+    if (!seg) { fprintf(stderr, "open failed\n"); return 1; }
+
+    t0 = std::chrono::steady_clock::now();
+    SessionHistory::SessionSummary sum;
+    for (uint32_t i = 0; i < seg->Size(); ++i) seg->DecodeSummary(i, sum);
+    double summariesMs = TestUtil::MsSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    size_t decodedRows = 0;
+    SessionHistory::SavedSession s;
+    for (uint32_t i = 0; i < seg->Size(); ++i)
+    {
+        if (!seg->Decode(i, s)) { fprintf(stderr, "decode failed\n"); return 1; }
+        decodedRows += s.items.size() + s.currencies.size();
+    }
+    double decodeMs = TestUtil::MsSince(t0);
+    std::filesystem::remove(path);
+
+    printf("synthetic history: %d sessions, %zu rows\n", sessionCount, rows);
+    printf("history.json: %.1f MB, parsed and imported in %.0f ms\n", text.size() / 1e6, jsonMs);
+    printf("segment:      %.2f MB, encoded in %.1f ms, opened in %.2f ms\n",
+           image.size() / 1e6, encodeMs, openMs);
+    printf("              every summary in %.1f ms, every body in %.1f ms\n", summariesMs, decodeMs);
+    return decodedRows == rows ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#include "HistoryStore.h"
+#include "TestUtil.h"
+
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+// HistoryStore round trips: sessions imported from history.json come back
+// from a segment field for field (unknown rarity/type spellings and negative
+// deltas included), summaries match Summarize, and truncated or corrupt
+// files are rejected rather than misread.
+
+using json = nlohmann::json;
+using SessionHistory::SavedSession;
+
+static std::string TempPath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static void WriteFile(const std::string& path, const std::string& data)
+{
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f.write(data.data(), (std::streamsize)data.size());
+}
+
+// A history.json as an older version wrote it, every field present.
+static json LegacyHistory()
+{
+    return json::parse(R"([
+      { "label": "Session 1", "startTimestamp": "2025-04-07T12:00:00Z",
+        "endTimestamp": "2025-04-07T13:00:00Z",
+        "items": [
+          { "id": 19721, "name": "Glob of Ectoplasm", "rarity": "Exotic", "delta": 250,
+            "type": "CraftingMaterial", "description": "Salvaged from rare items.", "vendorValue": 96 },
+          { "id": 70820, "name": "Shard of Glory", "rarity": "Rare", "delta": -42,
+            "type": "Trophy", "description": "", "vendorValue": 0 },
+          { "id": 99001, "name": "Newfangled Thing", "rarity": "Relic", "delta": 1,
+            "type": "Hoverboard", "description": "A rarity and type from a later update.",
+            "vendorValue": -5 }
+        ],
+        "currencies": [
+          { "id": 1, "name": "Coin", "delta": -123456789012 },
+          { "id": 2, "name": "Karma", "delta": 7 }
+        ] },
+      { "label": "Session 2", "startTimestamp": "2025-04-08T09:00:00Z",
+        "endTimestamp": "2025-04-08T09:30:00Z",
+        "items": [
+          { "id": 70820, "name": "Shard of Glory", "rarity": "Rare", "delta": 3,
+            "type": "Trophy", "description": "", "vendorValue": 0 },
+          { "id": 24, "name": "Vial of Blood", "rarity": "Basic", "delta": 0,
+            "type": "CraftingMaterial", "description": "", "vendorValue": 8 }
+        ],
+        "currencies": [] },
+      { "label": "", "startTimestamp": "", "endTimestamp": "", "items": [], "currencies": [] }
+    ])");
+}
+
+static std::vector<SavedSession> Import(const json& arr)
+{
+    std::vector<SavedSession> out;
+    size_t rows = 0;
+    for (auto& sess : arr) out.push_back(HistoryStore::FromJson(sess, rows));
+    CHECK(rows == 7);
+    return out;
+}
+
+static std::string EncodeAll(const std::vector<SavedSession>& sessions, uint32_t firstOrdinal)
+{
+    std::vector<const SavedSession*> ptrs;
+    for (auto& s : sessions) ptrs.push_back(&s);
+    return HistoryStore::Encode(ptrs, firstOrdinal);
+}
+
+static bool SameSummary(const SessionHistory::SessionSummary& a,
+                        const SessionHistory::SessionSummary& b)
+{
+    if (a.label != b.label || a.startTimestamp != b.startTimestamp ||
+        a.endTimestamp != b.endTimestamp || a.goldDelta != b.goldDelta ||
+        a.itemCount != b.itemCount || a.currencyCount != b.currencyCount ||
+        a.topItems.size() != b.topItems.size())
+        return false;
+    for (size_t i = 0; i < a.topItems.size(); ++i)
+        if (a.topItems[i].id != b.topItems[i].id || a.topItems[i].delta != b.topItems[i].delta)
+            return false;
+    return true;
+}
+
+static void TestRoundTrip()
+{
+    const json legacy = LegacyHistory();
+    std::vector<SavedSession> sessions = Import(legacy);
+
+    // The import itself loses nothing.
+    for (size_t i = 0; i < sessions.size(); ++i) CHECK(HistoryStore::ToJson(sessions[i]) == legacy[i]);
+
+    const std::string path = TempPath("loottracker-roundtrip.lth");
+    WriteFile(path, EncodeAll(sessions, 40));
+    auto seg = HistoryStore::Segment::Open(path);
+    CHECK(seg != nullptr);
+    if (!seg) return;
+    CHECK(seg->FirstOrdinal() == 40 && seg->Size() == sessions.size());
+
+    for (uint32_t i = 0; i < seg->Size(); ++i)
+    {
+        SavedSession s;
+        CHECK(seg->Decode(i, s));
+        CHECK(HistoryStore::ToJson(s) == legacy[i]);
+
+        SessionHistory::SessionSummary sum;
+        sum.ordinal = 40 + i;
+        CHECK(seg->DecodeSummary(i, sum));
+        CHECK(SameSummary(sum, SessionHistory::Summarize(sessions[i], 40 + i)));
+    }
+
+    // Rows back at 0 are saved but not counted.
+    SessionHistory::SessionSummary sum;
+    CHECK(seg->DecodeSummary(1, sum) && sum.itemCount == 1);
+
+    SavedSession s;
+    CHECK(!seg->Decode(seg->Size(), s));
+    std::filesystem::remove(path);
+
+    // Spellings the enums don't know still tell entries apart.
+    GW2Api::ItemInfo info{};
+    info.id     = 99001;
+    info.name   = "Newfangled Thing";
+    info.rarity = "Relic";
+    info.type   = "Hoverboard";
+    info.description = "A rarity and type from a later update.";
+    info.vendorValue = -5;
+    const Catalog::Item* relic = Catalog::RestoreItem(info);
+    info.rarity = "Celestial";
+    const Catalog::Item* celestial = Catalog::RestoreItem(info);
+    CHECK(relic == sessions[0].items[2].info && celestial != relic);
+    CHECK(Catalog::RarityName(*celestial) == "Celestial" && Catalog::TypeName(*celestial) == "Hoverboard");
+    CHECK(Catalog::RarityName(*sessions[0].items[0].info) == "Exotic");
+}
+
+// ── Damaged files ─────────────────────────────────────────────────────────────
+
+// True if seg is null or some session in it fails to decode.
+static bool Rejected(const std::shared_ptr<const HistoryStore::Segment>& seg)
+{
+    if (!seg) return true;
+    bool failed = false;
+    for (uint32_t i = 0; i < seg->Size(); ++i)
+    {
+        SavedSession s;
+        SessionHistory::SessionSummary sum;
+        if (!seg->Decode(i, s) || !seg->DecodeSummary(i, sum)) failed = true;
+    }
+    return failed;
+}
+
+static void TestDamaged()
+{
+    const std::string image = EncodeAll(Import(LegacyHistory()), 0);
+    const std::string path  = TempPath("loottracker-damaged.lth");
+
+    // The last body runs to the end of the file, so every cut shows.
+    for (size_t len = 0; len < image.size(); ++len)
+    {
+        WriteFile(path, image.substr(0, len));
+        CHECK(Rejected(HistoryStore::Segment::Open(path)));
+    }
+
+    auto corrupt = [&](size_t at, uint32_t v)
+    {
+        std::string bad = image;
+        memcpy(&bad[at], &v, 4);
+        WriteFile(path, bad);
+        return HistoryStore::Segment::Open(path);
+    };
+    CHECK(!corrupt(0, 0x4B4B4B4B));          // magic
+    CHECK(!corrupt(4, 0));                   // version
+    CHECK(!corrupt(4, 2));
+    CHECK(!corrupt(12, 0x7FFFFFFF));         // session count past the file
+    CHECK(!corrupt(16, 0x7FFFFFFF));         // item dictionary past the index
+    CHECK(!corrupt(24, (uint32_t)image.size() + 1)); // index offset
+
+    uint32_t indexOffset;
+    memcpy(&indexOffset, &image[24], 4);
+    CHECK(!corrupt(indexOffset, (uint32_t)image.size()));         // header offset
+    CHECK(!corrupt(indexOffset + 4, (uint32_t)image.size() + 1)); // body offset
+
+    // A body offset inside the file but wrong must not read past it.
+    CHECK(Rejected(corrupt(indexOffset + 4, (uint32_t)image.size() - 1)));
+
+    // Flipped bytes may decode to other values, but never read out of bounds.
+    for (size_t at = 0; at < image.size(); ++at)
+    {
+        std::string bad = image;
+        bad[at] = (char)~bad[at];
+        WriteFile(path, bad);
+        Rejected(HistoryStore::Segment::Open(path));
+    }
+
+    CHECK(!HistoryStore::Segment::Open(TempPath("loottracker-missing.lth")));
+    std::filesystem::remove(path);
+}
+
+int main()
+{
+    TestRoundTrip();
+    TestDamaged();
+    return TestUtil::Result();
+}
@@ -0,0 +1,89 @@
+#include "ItemSearch.h"
+#include "TestUtil.h"
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+// Profile editor search over a synthetic 30,000-item catalog: the time to
+// index it, then per-keystroke Find latency while typing queries, against a
+// lowercase-and-scan of every name (what the editor did before the index).
+//
+//   ItemSearchBench [items]
+
+static const char* WORDS[] = { "Shard", "of", "Glory", "Glob", "Ectoplasm", "Mighty", "Vial",
+                               "Blood", "Armor", "Pile", "Crystalline", "Dust", "Bottle",
+                               "Elder", "Wood", "Log", "Orichalcum", "Ore", "Recipe", "Mystic",
+                               "Coin", "Gift", "Exotic", "Berserker's", "Sword", "Greatsword" };
+static const char* TYPES[] = { "Trophy", "CraftingMaterial", "Consumable", "Armor", "Weapon",
+                               "Container", "Gizmo", "UpgradeComponent" };
+static const char* QUERIES[] = { "shard of glory", "ecto", "mighty blood", "recipe: ",
+                                 "berserker's greatsword", "qqq" };
+
+static std::string Lower(std::string_view s)
+{
+    std::string out(s);
+    for (auto& ch : out) ch = (char)std::tolower((unsigned char)ch);
+    return out;
+}
+
+int main(int argc, char** argv)
+{
+    const int items = argc > 1 ? std::max(1, atoi(argv[1])) : 30000;
+    const size_t words = sizeof(WORDS) / sizeof(*WORDS);
+
+    std::mt19937 rng(1);
+    for (int id = 1; id <= items; ++id)
+    {
+        GW2Api::ItemInfo info{};
+        info.id = id;
+        int n = 2 + rng() % 4;
+        for (int i = 0; i < n; ++i) info.name += std::string(i ? " " : "") + WORDS[rng() % words];
+        info.type = TYPES[rng() % 8];
+        Catalog::UpdateItem(info);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    ItemSearch::Sync();
+    double indexMs = TestUtil::MsSince(t0);
+    ItemSearch::Stats st = ItemSearch::GetStats();
+
+    // Every prefix of every query, as the user types it.
+    std::vector<const Catalog::Item*> all = Catalog::KnownItems();
+    double findMs = 0, scanMs = 0, worstFindMs = 0;
+    size_t keystrokes = 0, matches = 0;
+    for (const char* query : QUERIES)
+    {
+        std::string q(query);
+        for (size_t len = 1; len <= q.size(); ++len)
+        {
+            std::string typed = q.substr(0, len);
+
+            t0 = std::chrono::steady_clock::now();
+            size_t found = ItemSearch::Find(typed).size();
+            double ms = TestUtil::MsSince(t0);
+            findMs += ms;
+            worstFindMs = std::max(worstFindMs, ms);
+
+            t0 = std::chrono::steady_clock::now();
+            size_t scanned = 0;
+            for (const Catalog::Item* item : all)
+                if (Lower(item->name).find(typed) != std::string::npos) ++scanned;
+            scanMs += TestUtil::MsSince(t0);
+
+            if (found != scanned) { fprintf(stderr, "mismatch on \"%s\"\n", typed.c_str()); return 1; }
+            matches += found;
+            ++keystrokes;
+        }
+    }
+
+    printf("synthetic catalog: %zu items, %zu trigrams, %zu postings; indexed in %.1f ms\n",
+           st.liveDocs, st.trigrams, st.postings, indexMs);
+    printf("index: %.3f ms/keystroke (worst %.3f ms) over %zu keystrokes, %zu matches\n",
+           findMs / keystrokes, worstFindMs, keystrokes, matches);
+    printf("scan:  %.3f ms/keystroke\n", scanMs / keystrokes);
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "ItemSearch.h"
+#include "TestUtil.h"
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+// ItemSearch::Find against a brute-force substring filter over the catalog,
+// across Syncs that add items and supersede others: growing queries (the
+// narrowing path), queries that aren't extensions, short and mixed-case
+// queries.  Types the enum doesn't know sort by spelling.  Once superseded
+// entries pile up their postings are dropped.
+
+static const char* SYLLABLES[] = { "sha", "rd", "of", " ", "glo", "ry", "ecto", "pla", "sm",
+                                   "mi", "ght", "Vi", "al", "Bl", "ood", "-", "ar", "mor" };
+static const char* TYPES[]     = { "Trophy", "CraftingMaterial", "Consumable", "Armor", "Weapon",
+                                   "Hoverboard", "Skiff" }; // the last two are Unknown
+
+static std::string RandomName(std::mt19937& rng)
+{
+    std::string name;
+    int parts = 2 + rng() % 5;
+    for (int i = 0; i < parts; ++i) name += SYLLABLES[rng() % (sizeof(SYLLABLES) / sizeof(*SYLLABLES))];
+    return name;
+}
+
+static void Update(std::mt19937& rng, int id)
+{
+    GW2Api::ItemInfo info{};
+    info.id   = id;
+    info.name = RandomName(rng) + " " + std::to_string(rng() % 1000);
+    info.type = TYPES[rng() % (sizeof(TYPES) / sizeof(*TYPES))];
+    Catalog::UpdateItem(info);
+}
+
+static std::string Lower(std::string s)
+{
+    for (auto& ch : s) ch = (char)std::tolower((unsigned char)ch);
+    return s;
+}
+
+static std::vector<const Catalog::Item*> BruteForce(const std::string& query)
+{
+    std::string q = Lower(query);
+    std::vector<const Catalog::Item*> out;
+    for (const Catalog::Item* item : Catalog::KnownItems())
+        if (Lower(std::string(item->name)).find(q) != std::string::npos) out.push_back(item);
+    std::sort(out.begin(), out.end(), [](const Catalog::Item* x, const Catalog::Item* y)
+    {
+        if (x->type != y->type) return x->type < y->type;
+        if (Catalog::TypeName(*x) != Catalog::TypeName(*y))
+            return Catalog::TypeName(*x) < Catalog::TypeName(*y);
+        if (x->name != y->name) return x->name < y->name;
+        return x->id < y->id;
+    });
+    return out;
+}
+
+static size_t LivePostings()
+{
+    size_t n = 0;
+    for (const Catalog::Item* item : Catalog::KnownItems())
+    {
+        std::string s = Lower(std::string(item->name));
+        std::vector<std::string> tri;
+        for (size_t i = 0; i + 3 <= s.size(); ++i) tri.push_back(s.substr(i, 3));
+        std::sort(tri.begin(), tri.end());
+        n += std::unique(tri.begin(), tri.end()) - tri.begin();
+    }
+    return n;
+}
+
+int main()
+{
+    std::mt19937 rng(7);
+    int nextId = 1;
+    size_t queries = 0;
+
+    for (int round = 0; round < 30; ++round)
+    {
+        // New items, and a few existing ones renamed by a "game build".
+        for (int i = 0; i < 150; ++i) Update(rng, nextId++);
+        for (int i = 0; i < 40; ++i) Update(rng, 1 + rng() % (nextId - 1));
+        ItemSearch::Sync();
+
+        for (int q = 0; q < 10; ++q)
+        {
+            // Type out part of a current name one key at a time, sometimes
+            // in capitals, then jump to something that doesn't extend it.
+            std::string name(Catalog::ItemFor(1 + rng() % (nextId - 1))->name);
+            size_t from = rng() % name.size();
+            std::string typed;
+            for (size_t i = from; i < name.size() && i < from + 8; ++i)
+            {
+                typed += q % 3 == 0 ? (char)std::toupper((unsigned char)name[i]) : name[i];
+                CHECK(ItemSearch::Find(typed) == BruteForce(typed));
+                ++queries;
+            }
+            std::string other = typed.size() > 1 ? typed.substr(1) : "zzz";
+            CHECK(ItemSearch::Find(other) == BruteForce(other));
+            CHECK(ItemSearch::Find("") == BruteForce(""));
+            queries += 2;
+        }
+
+        // A query answered before a Sync must not be narrowed from after it.
+        ItemSearch::Find("ar");
+        Update(rng, 1 + rng() % (nextId - 1));
+        Update(rng, nextId++);
+        ItemSearch::Sync();
+        CHECK(ItemSearch::Find("ar") == BruteForce("ar"));
+        CHECK(ItemSearch::Find("arm") == BruteForce("arm"));
+        queries += 2;
+    }
+
+    ItemSearch::Stats st = ItemSearch::GetStats();
+    CHECK(st.liveDocs == Catalog::KnownItems().size());
+
+    // Rename everything: half the docs are now dead, well past the prune
+    // threshold, so only the current names stay posted.
+    for (int id = 1; id < nextId; ++id) Update(rng, id);
+    ItemSearch::Sync();
+    st = ItemSearch::GetStats();
+    CHECK(st.liveDocs == (size_t)(nextId - 1));
+    CHECK(st.postings == LivePostings());
+    CHECK(ItemSearch::Find("sha") == BruteForce("sha"));
+
+    printf("%zu queries over %zu items (%zu entries indexed)\n", queries, st.liveDocs, st.docs);
+    return TestUtil::Result();
+}
@@ -0,0 +1,106 @@
+#include "ItemStreamParser.h"
+#include "TestUtil.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// ItemStreamParser over every chunk split of small documents: nested values
+// and escaped strings are skipped, slot markers and bag slot indices are
+// assigned, malformed input is rejected, and Reset() recovers after it.
+
+using Layout = ItemStreamParser::Layout;
+
+static bool Parse(ItemStreamParser& p, const std::string& doc, size_t chunk)
+{
+    bool ok = true;
+    for (size_t i = 0; i < doc.size(); i += chunk)
+        ok = p.Feed(doc.data() + i, std::min(chunk, doc.size() - i)) && ok;
+    return p.Finish() && ok;
+}
+
+static void TestAccountSlots()
+{
+    const std::string doc =
+        R"([{"id":19721,"count":250,"binding":"Account","upgrades":[24615,{"x":1}],)"
+        R"("stats":{"id":99,"attributes":{"Power":5}}}, null ,{"id":12,"count":0},)"
+        R"({"id":5,"count":3,"name":"a\"id\\"}, {"id":7}])";
+    for (size_t chunk = 1; chunk <= doc.size(); ++chunk)
+    {
+        std::vector<GW2Api::ItemStack> out;
+        ItemStreamParser p(Layout::AccountSlots, -2, out);
+        CHECK(Parse(p, doc, chunk));
+        // count 0 and a missing count are dropped; nested "id"s are not items.
+        CHECK(out.size() == 2);
+        if (out.size() != 2) continue;
+        CHECK(out[0].id == 19721 && out[0].count == 250 && out[0].slot == -2);
+        CHECK(out[1].id == 5 && out[1].count == 3 && out[1].slot == -2);
+    }
+}
+
+static void TestCharacterBags()
+{
+    const std::string doc =
+        R"({"bags":[{"id":8932,"size":4,"inventory":[null,{"id":1,"count":2,"infusions":[3]},null,)"
+        R"({"id":4,"count":1}]},null,{"id":1,"size":2,"inventory":[{"id":9,"count":10},null]}]})";
+    for (size_t chunk = 1; chunk <= doc.size(); ++chunk)
+    {
+        std::vector<GW2Api::ItemStack> out;
+        ItemStreamParser p(Layout::CharacterBags, 0, out);
+        CHECK(Parse(p, doc, chunk));
+        CHECK(out.size() == 3);
+        if (out.size() != 3) continue;
+        // Slots count across bags; a missing bag takes one slot index, as
+        // the DOM version did.
+        CHECK(out[0].id == 1 && out[0].count == 2 && out[0].slot == 1);
+        CHECK(out[1].id == 4 && out[1].count == 1 && out[1].slot == 3);
+        CHECK(out[2].id == 9 && out[2].count == 10 && out[2].slot == 5);
+    }
+}
+
+static void TestMalformed()
+{
+    const char* bad[] = {
+        "[", "[{]", R"({"id":1})", R"([{"id":1,}])", "[1,]x", "[] []", "[nul]",
+        R"([{"id":1.5,"count":1}])", R"([{"id":1 "count":1}])", "",
+    };
+    for (const char* doc : bad)
+    {
+        std::vector<GW2Api::ItemStack> out;
+        ItemStreamParser p(Layout::AccountSlots, -1, out);
+        bool ok = Parse(p, doc, 3);
+        if (ok) fprintf(stderr, "accepted: %s\n", doc);
+        CHECK(!ok);
+    }
+}
+
+static void TestReset()
+{
+    std::vector<GW2Api::ItemStack> out;
+    ItemStreamParser p(Layout::AccountSlots, -3, out);
+
+    // Cut off mid-string, then a whole document after Reset().
+    CHECK(!Parse(p, R"([{"id":1,"count":2},{"na)", 4));
+    out.clear();
+    p.Reset();
+    CHECK(Parse(p, R"([{"id":6,"count":1}])", 4));
+    CHECK(out.size() == 1 && out[0].id == 6 && out[0].slot == -3);
+
+    // A malformed document doesn't stick either.
+    out.clear();
+    p.Reset();
+    CHECK(!Parse(p, "[nul]", 1));
+    out.clear();
+    p.Reset();
+    CHECK(Parse(p, R"([null,{"id":8,"count":4}])", 1));
+    CHECK(out.size() == 1 && out[0].id == 8 && out[0].count == 4);
+}
+
+int main()
+{
+    TestAccountSlots();
+    TestCharacterBags();
+    TestMalformed();
+    TestReset();
+    return TestUtil::Result();
+}
@@ -0,0 +1,174 @@
+#include "MockApiServer.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+#include <cctype>
+#include <chrono>
+
+// Longest request head accepted; GW2Api's are a few hundred bytes.
+static const size_t MAX_HEAD_BYTES = 16 * 1024;
+
+static bool SendAll(int fd, const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+// Value of header name (lower case) in a request head, or "".
+static std::string HeaderValue(const std::string& head, const char* name)
+{
+    size_t pos = head.find("\r\n");
+    while (pos != std::string::npos && pos + 2 < head.size())
+    {
+        size_t start = pos + 2;
+        size_t end   = head.find("\r\n", start);
+        if (end == std::string::npos) end = head.size();
+        size_t colon = head.find(':', start);
+        if (colon != std::string::npos && colon < end)
+        {
+            std::string key = head.substr(start, colon - start);
+            for (auto& c : key) c = (char)tolower((unsigned char)c);
+            if (key == name)
+            {
+                size_t v = head.find_first_not_of(' ', colon + 1);
+                return v < end ? head.substr(v, end - v) : std::string();
+            }
+        }
+        pos = end;
+    }
+    return {};
+}
+
+MockApiServer::MockApiServer()
+{
+    m_Listen = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(m_Listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = 0;
+    bind(m_Listen, (sockaddr*)&addr, sizeof(addr));
+    listen(m_Listen, 64);
+
+    socklen_t len = sizeof(addr);
+    getsockname(m_Listen, (sockaddr*)&addr, &len);
+    m_Port = ntohs(addr.sin_port);
+
+    m_AcceptThread = std::thread(&MockApiServer::AcceptLoop, this);
+}
+
+MockApiServer::~MockApiServer()
+{
+    m_Stopping = true;
+    shutdown(m_Listen, SHUT_RDWR); // wakes accept()
+    m_AcceptThread.join();
+    close(m_Listen);
+
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (int fd : m_Connections) shutdown(fd, SHUT_RDWR); // wakes recv()
+        threads.swap(m_Threads);
+    }
+    for (auto& t : threads) t.join();
+}
+
+void MockApiServer::SetRoute(const std::string& path, Route route)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Routes[path] = std::move(route);
+}
+
+void MockApiServer::ResetStats()
+{
+    m_Requests    = 0;
+    m_MaxInFlight = 0;
+}
+
+void MockApiServer::AcceptLoop()
+{
+    while (!m_Stopping)
+    {
+        int fd = accept(m_Listen, nullptr, nullptr);
+        if (fd < 0) continue; // interrupted, or shut down (checked above)
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Stopping) { close(fd); break; }
+        m_Connections.push_back(fd);
+        m_Threads.emplace_back(&MockApiServer::Serve, this, fd);
+    }
+}
+
+void MockApiServer::Serve(int fd)
+{
+    std::string buffered;
+    char        buf[4096];
+    for (;;)
+    {
+        size_t headEnd;
+        while ((headEnd = buffered.find("\r\n\r\n")) == std::string::npos)
+        {
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0 || buffered.size() > MAX_HEAD_BYTES) goto done;
+            buffered.append(buf, (size_t)n);
+        }
+
+        {
+            // "GET <path> HTTP/1.1"; requests carry no body.
+            std::string head = buffered.substr(0, headEnd + 2);
+            buffered.erase(0, headEnd + 4);
+            size_t sp1 = head.find(' ');
+            size_t sp2 = head.find(' ', sp1 + 1);
+            if (sp1 == std::string::npos || sp2 == std::string::npos) break;
+            if (!Answer(fd, head.substr(sp1 + 1, sp2 - sp1 - 1), HeaderValue(head, "if-none-match")))
+                break;
+        }
+    }
+done:
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto it = m_Connections.begin(); it != m_Connections.end(); ++it)
+        if (*it == fd) { m_Connections.erase(it); break; }
+    close(fd);
+}
+
+bool MockApiServer::Answer(int fd, const std::string& path, const std::string& ifNoneMatch)
+{
+    Route route;
+    bool  found;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Routes.find(path);
+        found = it != m_Routes.end();
+        if (found) route = it->second;
+    }
+    if (!found) route.status = 404;
+
+    int inFlight = ++m_InFlight;
+    for (int seen = m_MaxInFlight; inFlight > seen && !m_MaxInFlight.compare_exchange_weak(seen, inFlight);) {}
+    if (route.delayMs > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(route.delayMs));
+    --m_InFlight;
+    ++m_Requests;
+
+    const bool notModified = !route.etag.empty() && ifNoneMatch == route.etag;
+    const int  status      = notModified ? 304 : route.status;
+    std::string response = "HTTP/1.1 " + std::to_string(status) + " X\r\n";
+    if (!route.etag.empty()) response += "ETag: " + route.etag + "\r\n";
+    if (notModified)
+        response += "\r\n";
+    else
+        response += "Content-Type: application/json\r\nContent-Length: " +
+                    std::to_string(route.body.size()) + "\r\n\r\n" + route.body;
+    return SendAll(fd, response);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+// ── Local mock of the GW2 API ─────────────────────────────────────────────────
+// Plain HTTP/1.1 on 127.0.0.1 (an ephemeral port), for driving GW2Api through
+// the socket transport.  One thread per connection, keep-alive.  Each path
+// answers with a canned body after an optional delay; an If-None-Match equal
+// to the route's ETag gets 304.  Paths without a route get 404.  POSIX only.
+class MockApiServer
+{
+public:
+    struct Route
+    {
+        int         status  = 200;
+        std::string body;
+        std::string etag;        // sent when set
+        int         delayMs = 0; // before the response, standing in for the network
+    };
+
+    // Listens straight away; Port() is valid once this returns.
+    MockApiServer();
+    ~MockApiServer();
+    MockApiServer(const MockApiServer&)            = delete;
+    MockApiServer& operator=(const MockApiServer&) = delete;
+
+    int  Port() const { return m_Port; }
+    void SetRoute(const std::string& path, Route route);
+
+    // Requests answered, and the most that were being handled at once.
+    int  Requests() const    { return m_Requests.load(); }
+    int  MaxInFlight() const { return m_MaxInFlight.load(); }
+    void ResetStats();
+
+private:
+    void AcceptLoop();
+    void Serve(int fd);
+    bool Answer(int fd, const std::string& path, const std::string& ifNoneMatch);
+
+    int               m_Listen = -1;
+    int               m_Port   = 0;
+    std::atomic<bool> m_Stopping{ false };
+    std::thread       m_AcceptThread;
+
+    std::mutex                   m_Mutex; // routes, connections
+    std::map<std::string, Route> m_Routes;
+    std::vector<int>             m_Connections;
+    std::vector<std::thread>     m_Threads;
+
+    std::atomic<int> m_Requests{ 0 };
+    std::atomic<int> m_InFlight{ 0 };
+    std::atomic<int> m_MaxInFlight{ 0 };
+};
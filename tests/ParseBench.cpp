@@ -0,0 +1,91 @@
+#include "ItemStreamParser.h"
+#include "AllocCounter.h"
+#include "TestUtil.h"
+
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+
+// Parse time and heap allocations for a synthetic 3,000-slot bank, fed in
+// 8 KB chunks as the transport delivers it.  "DOM" is what FetchSnapshot did
+// before the stream parser: json::parse, then copy id and count out.
+//
+//   ParseBench [iterations]
+
+using json = nlohmann::json;
+
+static const size_t CHUNK = 8 * 1024;
+
+static std::string SyntheticBank(int slots)
+{
+    std::mt19937 rng(1);
+    std::string s = "[";
+    for (int i = 0; i < slots; ++i)
+    {
+        if (i) s += ",";
+        if (rng() % 4 == 0) { s += "null"; continue; }
+        s += "{\"id\":" + std::to_string(rng() % 90000) + ",\"count\":" +
+             std::to_string(1 + rng() % 250) +
+             ",\"binding\":\"Account\",\"upgrades\":[24615],\"infusions\":[49432]}";
+    }
+    return s + "]";
+}
+
+static void ParseDom(const std::string& body, std::vector<GW2Api::ItemStack>& out)
+{
+    json j = json::parse(body);
+    for (auto& slot : j)
+    {
+        if (slot.is_null()) continue;
+        int count = slot.value("count", 0);
+        if (count > 0) out.push_back({ slot["id"].get<int>(), count, -2 });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 200;
+    const std::string bank = SyntheticBank(3000);
+
+    std::vector<GW2Api::ItemStack> out;
+    ItemStreamParser parser(ItemStreamParser::Layout::AccountSlots, -2, out);
+    auto stream = [&]
+    {
+        out.clear();
+        parser.Reset();
+        for (size_t i = 0; i < bank.size(); i += CHUNK)
+            parser.Feed(bank.data() + i, std::min(CHUNK, bank.size() - i));
+        return parser.Finish();
+    };
+    auto dom = [&]
+    {
+        out.clear();
+        ParseDom(bank, out);
+        return true;
+    };
+
+    // First run warms the buffers; the rest are the steady state.
+    struct Result { double ms; uint64_t allocs; size_t stacks; };
+    auto run = [&](auto&& parse)
+    {
+        if (!parse()) { fprintf(stderr, "parse failed\n"); exit(1); }
+        uint64_t a0 = AllocCounter::ThisThread();
+        auto     t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) parse();
+        return Result{ TestUtil::MsSince(t0) / iterations,
+                       (AllocCounter::ThisThread() - a0) / iterations, out.size() };
+    };
+
+    Result s = run(stream);
+    Result d = run(dom);
+    printf("synthetic bank: 3000 slots, %zu bytes, %zu stacks\n", bank.size(), s.stacks);
+    printf("stream parser: %.3f ms/parse, %llu allocations/parse\n",
+           s.ms, (unsigned long long)s.allocs);
+    printf("json DOM:      %.3f ms/parse, %llu allocations/parse\n",
+           d.ms, (unsigned long long)d.allocs);
+    if (!AllocCounter::Enabled()) printf("(allocations not counted in this build)\n");
+    return s.stacks == d.stacks ? 0 : 1;
+}
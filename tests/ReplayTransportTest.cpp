@@ -0,0 +1,121 @@
+#include "HttpTransport.h"
+#include "TestUtil.h"
+
+#include <zlib.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+// Recording and replaying a gzip response: the capture keeps the body as it
+// came off the wire, both transports hand back the inflated body (buffered,
+// in an arena, streamed), validators are answered locally, and each response
+// is counted in the transfer stats exactly once.
+
+static std::string Gzip(const std::string& in)
+{
+    z_stream zs{};
+    deflateInit2(&zs, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&zs, (uLong)in.size()), '\0');
+    zs.next_in   = (Bytef*)in.data();
+    zs.avail_in  = (uInt)in.size();
+    zs.next_out  = (Bytef*)&out[0];
+    zs.avail_out = (uInt)out.size();
+    deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+// Answers every request with the same gzip body, as a server would for a
+// raw request; anything else would mean the recorder asked for a decoded one.
+class GzipTransport : public Http::ITransport
+{
+public:
+    explicit GzipTransport(std::string wire) : m_Wire(std::move(wire)) {}
+
+    bool Get(const Http::Request& req, Http::Response& out) override
+    {
+        ++gets;
+        if (!req.raw || !req.ifNoneMatch.empty()) ++unexpected;
+        out.status          = 200;
+        out.etag            = "\"e1\"";
+        out.lastModified.clear();
+        out.contentEncoding = "gzip";
+        out.body            = m_Wire;
+        return true;
+    }
+
+    void Close() override {}
+
+    int gets       = 0;
+    int unexpected = 0;
+
+private:
+    const std::string m_Wire;
+};
+
+int main()
+{
+    std::string body;
+    for (int i = 0; i < 2000; ++i)
+        body += "{\"id\":" + std::to_string(i) + ",\"count\":250,\"binding\":\"Account\"},";
+    const std::string wire = Gzip(body);
+
+    const std::string dir =
+        (std::filesystem::temp_directory_path() / "loottracker-replay-test").string();
+    std::filesystem::remove_all(dir);
+
+    auto inner = std::make_shared<GzipTransport>(wire);
+    std::unique_ptr<Http::ITransport> recorder = Http::CreateRecordingTransport(inner, dir);
+
+    Http::Request req;
+    req.path = L"/v2/account/bank";
+    Http::Response resp;
+
+    // Record: one buffered response, counted once at its compressed size.
+    Http::TransferStats st0 = Http::GetTransferStats();
+    CHECK(recorder->Get(req, resp) && resp.status == 200 && resp.body == body);
+    CHECK(resp.contentEncoding.empty());
+    Http::TransferStats st1 = Http::GetTransferStats();
+    CHECK(st1.responses - st0.responses == 1);
+    CHECK(st1.compressedResponses - st0.compressedResponses == 1);
+    CHECK(st1.wireBytes - st0.wireBytes == wire.size());
+    CHECK(st1.decodedBytes - st0.decodedBytes == body.size());
+
+    // The recorder fetches in full even when the caller holds a validator.
+    req.ifNoneMatch = "\"e1\"";
+    CHECK(recorder->Get(req, resp) && resp.status == 304 && resp.body.empty());
+    CHECK(inner->gets == 2 && inner->unexpected == 0);
+
+    // The capture holds what the server sent, not the inflated body.
+    size_t captured = 0;
+    for (auto& entry : std::filesystem::directory_iterator(dir))
+        captured += entry.file_size();
+    CHECK(captured > wire.size() && captured < body.size());
+
+    // Replay inflates it again, into an arena and through onData alike.
+    std::unique_ptr<Http::ITransport> replay = Http::CreateReplayTransport(dir, 0);
+    Http::ResponseArena arena;
+    req.ifNoneMatch.clear();
+    req.arena = &arena;
+    st0 = Http::GetTransferStats();
+    CHECK(replay->Get(req, resp) && resp.status == 200 && arena.View() == body);
+    st1 = Http::GetTransferStats();
+    CHECK(st1.responses - st0.responses == 1);
+    CHECK(st1.wireBytes - st0.wireBytes == wire.size());
+    CHECK(st1.decodedBytes - st0.decodedBytes == body.size());
+
+    std::string streamed;
+    req.arena  = nullptr;
+    req.onData = [&streamed](const char* data, size_t len) { streamed.append(data, len); };
+    CHECK(replay->Get(req, resp) && resp.status == 200 && resp.body.empty() && streamed == body);
+
+    req.ifNoneMatch = "\"e1\"";
+    CHECK(replay->Get(req, resp) && resp.status == 304);
+
+    req.path = L"/v2/account/wallet";
+    CHECK(replay->Get(req, resp) && resp.status == 404);
+
+    std::filesystem::remove_all(dir);
+    return TestUtil::Result();
+}
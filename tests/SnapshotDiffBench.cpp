@@ -0,0 +1,135 @@
+#include "SnapshotDiff.h"
+#include "AllocCounter.h"
+#include "TestUtil.h"
+
+#include <unordered_map>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+
+// Diff time and heap allocations per poll for a synthetic account with a few
+// thousand stacks.  "sorted" is NormalizeItems + DiffItems + NormalizeWallet
+// + DiffWallet; "map" is what LootSession::OnSnapshot did before: hash the
+// snapshot into unordered_maps, then look every ID up in the baseline maps.
+//
+//   SnapshotDiffBench [iterations]
+
+static const int STACKS = 6000;
+
+struct Poll
+{
+    std::vector<GW2Api::ItemStack>   items;
+    std::vector<GW2Api::WalletEntry> wallet;
+};
+
+// Bank, materials and bags: the same few thousand items from poll to poll,
+// with a handful of counts changing.
+static Poll SyntheticPoll(int variant)
+{
+    std::mt19937 rng(1);
+    Poll p;
+    for (int i = 0; i < STACKS; ++i)
+        p.items.push_back({ int(rng() % 90000), 1 + int(rng() % 250), -2 });
+    std::mt19937 change(variant + 2);
+    for (int i = 0; i < 20; ++i) p.items[change() % STACKS].count += 1 + variant;
+    for (int id = 1; id <= 75; ++id) p.wallet.push_back({ id, int64_t(id) * 1000 + variant });
+    return p;
+}
+
+// The old diff, without the info-cache and pending-ID bookkeeping.
+struct MapDiff
+{
+    std::unordered_map<int, int64_t> baseWallet, deltaWallet;
+    std::unordered_map<int, int>     baseItems, deltaItems;
+
+    void Run(const Poll& p, bool rebase)
+    {
+        std::unordered_map<int, int64_t> newWallet;
+        for (auto& w : p.wallet) newWallet[w.id] = w.value;
+        std::unordered_map<int, int> newItems;
+        for (auto& it : p.items) newItems[it.id] += it.count;
+
+        if (rebase)
+        {
+            baseWallet = newWallet;
+            baseItems  = newItems;
+            return;
+        }
+        for (auto& [id, val] : newWallet)
+        {
+            auto it = baseWallet.find(id);
+            deltaWallet[id] = val - (it != baseWallet.end() ? it->second : 0);
+        }
+        for (auto& [id, cnt] : newItems)
+        {
+            auto it = baseItems.find(id);
+            int d = cnt - (it != baseItems.end() ? it->second : 0);
+            if (d != 0) deltaItems[id] = d;
+        }
+        for (auto& [id, base] : baseItems)
+            if (newItems.find(id) == newItems.end()) deltaItems[id] = -base;
+    }
+};
+
+struct SortedDiff
+{
+    SnapshotDiff::ItemColumns    cur;
+    SnapshotDiff::ItemDeltas     items;
+    SnapshotDiff::WalletColumns  baseWallet, curWallet;
+    SnapshotDiff::CurrencyDeltas wallet;
+    std::vector<GW2Api::ItemStack> stacks;
+    std::vector<int>             newlyShown, added;
+
+    void Run(const Poll& p, bool rebase)
+    {
+        stacks = p.items; // FetchSnapshot's reused buffer; same size, no allocation
+        SnapshotDiff::NormalizeItems(stacks, cur);
+        if (rebase)
+        {
+            SnapshotDiff::Rebase(items, cur);
+            SnapshotDiff::NormalizeWallet(p.wallet, baseWallet);
+            return;
+        }
+        newlyShown.clear();
+        added.clear();
+        SnapshotDiff::DiffItems(items, cur, newlyShown);
+        SnapshotDiff::NormalizeWallet(p.wallet, curWallet);
+        SnapshotDiff::DiffWallet(baseWallet, curWallet, wallet, added);
+    }
+};
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 500;
+    const Poll polls[2] = { SyntheticPoll(0), SyntheticPoll(1) };
+
+    // Rebase, then two polls to warm the buffers; the rest are the steady state.
+    struct Result { double ms; uint64_t allocs; };
+    auto run = [&](auto& diff)
+    {
+        diff.Run(polls[0], true);
+        diff.Run(polls[1], false);
+        diff.Run(polls[0], false);
+        uint64_t a0 = AllocCounter::ThisThread();
+        auto     t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) diff.Run(polls[i % 2], false);
+        return Result{ TestUtil::MsSince(t0) / iterations,
+                       (AllocCounter::ThisThread() - a0) / iterations };
+    };
+
+    SortedDiff sorted;
+    MapDiff    map;
+    Result s = run(sorted);
+    Result m = run(map);
+
+    size_t shown = std::count(sorted.items.shown.begin(), sorted.items.shown.end(), 1);
+    printf("synthetic account: %d stacks, %zu distinct items, %zu currencies\n",
+           STACKS, sorted.items.ids.size(), polls[0].wallet.size());
+    printf("sorted merge: %.3f ms/poll, %llu allocations/poll\n",
+           s.ms, (unsigned long long)s.allocs);
+    printf("map diff:     %.3f ms/poll, %llu allocations/poll\n",
+           m.ms, (unsigned long long)m.allocs);
+    if (!AllocCounter::Enabled()) printf("(allocations not counted in this build)\n");
+    return shown == map.deltaItems.size() ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include "SnapshotDiff.h"
+#include "AllocCounter.h"
+#include "TestUtil.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+// SnapshotDiff against a map-based reference over random polls: rows stay
+// sorted, shown rows carry the reference deltas (including items that return
+// to their baseline count), and wallet IDs outside the dense range diff
+// through the overflow list.  Once its buffers are warm, a diff of a poll
+// with no new IDs makes no heap allocation.
+
+using namespace SnapshotDiff;
+
+static std::vector<GW2Api::ItemStack> RandomStacks(std::mt19937& rng)
+{
+    std::vector<GW2Api::ItemStack> v;
+    int n = rng() % 50;
+    for (int i = 0; i < n; ++i) v.push_back({ int(rng() % 40), int(rng() % 5 + 1), 0 });
+    return v;
+}
+
+static void TestItems()
+{
+    std::mt19937 rng(1);
+    for (int round = 0; round < 200; ++round)
+    {
+        auto base = RandomStacks(rng);
+        std::map<int, int> baseCounts;
+        for (auto& s : base) baseCounts[s.id] += s.count;
+
+        ItemColumns baseCols;
+        NormalizeItems(base, baseCols);
+        ItemDeltas d;
+        Rebase(d, baseCols);
+
+        std::map<int, int> shown; // reference: id -> delta, for rows ever non-zero
+        for (int poll = 0; poll < 10; ++poll)
+        {
+            auto cur = RandomStacks(rng);
+            std::map<int, int> curCounts;
+            for (auto& s : cur) curCounts[s.id] += s.count;
+
+            ItemColumns curCols;
+            NormalizeItems(cur, curCols);
+            std::vector<int> newlyShown;
+            DiffItems(d, curCols, newlyShown);
+
+            std::map<int, int> before = shown;
+            std::map<int, int> ids;
+            for (auto& [id, c] : baseCounts) ids[id];
+            for (auto& [id, c] : curCounts)  ids[id];
+            for (auto& [id, unused] : ids)
+            {
+                int delta = curCounts[id] - baseCounts[id];
+                if (delta != 0 || shown.count(id)) shown[id] = delta;
+            }
+
+            std::map<int, int> got;
+            bool sorted = true;
+            for (size_t i = 0; i < d.ids.size(); ++i)
+            {
+                if (i > 0 && d.ids[i - 1] >= d.ids[i]) sorted = false;
+                if (d.shown[i]) got[d.ids[i]] = d.delta[i];
+            }
+            CHECK(sorted);
+            CHECK(got == shown);
+
+            // newlyShown lists exactly the rows that became shown.
+            std::map<int, int> fresh = before;
+            for (int id : newlyShown) CHECK(fresh.count(id) == 0 && shown.count(id) == 1);
+            for (int id : newlyShown) fresh[id];
+            CHECK(fresh.size() == shown.size());
+        }
+    }
+}
+
+static void TestWallet()
+{
+    WalletColumns base, cur;
+    CHECK(NormalizeWallet({ { 5, 3 }, { 1, 10 }, { 100000, 7 } }, base) == 1);
+    CHECK(NormalizeWallet({ { 1, 12 }, { 100000, 9 }, { -3, 4 } }, cur) == 2);
+    CHECK(cur.ValueOf(100000) == 9 && cur.ValueOf(-3) == 4 && cur.ValueOf(1) == 12);
+
+    CurrencyDeltas out;
+    std::vector<int> added;
+    DiffWallet(base, cur, out, added);
+
+    const int     ids[]    = { -3, 1, 5, 100000 };
+    const int64_t deltas[] = { 4, 2, -3, 2 };
+    CHECK(out.ids.size() == 4);
+    for (size_t i = 0; i < 4 && i < out.ids.size(); ++i)
+        CHECK(out.ids[i] == ids[i] && out.delta[i] == deltas[i]);
+    CHECK(added.size() == 1 && added[0] == -3);
+
+    // Values stale from an earlier snapshot are never read.
+    CHECK(NormalizeWallet({ { 1, 12 } }, cur) == 0);
+    out = {};
+    added.clear();
+    DiffWallet(base, cur, out, added);
+    CHECK(out.ids.size() == 3 && out.delta[1] == -3 && out.delta[2] == -7);
+}
+
+static void TestSteadyStateAllocations()
+{
+    CHECK(AllocCounter::Enabled());
+
+    // Two polls over the same IDs, alternating counts; the second variant
+    // also carries an overflow currency, so that list is reused too.
+    std::vector<GW2Api::ItemStack> polls[2];
+    std::vector<GW2Api::WalletEntry> wallets[2];
+    for (int v = 0; v < 2; ++v)
+    {
+        for (int i = 0; i < 3000; ++i)
+            polls[v].push_back({ 20000 + (i * 7919) % 5000, 1 + (i + v) % 9, 0 });
+        for (int id = 1; id < 70; ++id) wallets[v].push_back({ id, int64_t(id) * 100 + v });
+        wallets[v].push_back({ 100000, 5 + v });
+    }
+
+    ItemColumns base, cur;
+    std::vector<GW2Api::ItemStack> stacks = polls[0];
+    NormalizeItems(stacks, base);
+    ItemDeltas d;
+    Rebase(d, base);
+    WalletColumns baseWallet, curWallet;
+    NormalizeWallet(wallets[0], baseWallet);
+    CurrencyDeltas out;
+    std::vector<int> newlyShown, added;
+
+    for (int poll = 0; poll < 6; ++poll)
+    {
+        // The poll's stacks arrive in a buffer FetchSnapshot reuses; the
+        // copy here stands in for that and is not counted.
+        stacks = polls[poll % 2];
+        newlyShown.clear();
+        added.clear();
+        uint64_t a0 = AllocCounter::ThisThread();
+        NormalizeItems(stacks, cur);
+        DiffItems(d, cur, newlyShown);
+        NormalizeWallet(wallets[poll % 2], curWallet);
+        DiffWallet(baseWallet, curWallet, out, added);
+        uint64_t allocs = AllocCounter::ThisThread() - a0;
+        if (poll >= 2) CHECK(allocs == 0);
+    }
+}
+
+int main()
+{
+    TestItems();
+    TestWallet();
+    TestSteadyStateAllocations();
+    return TestUtil::Result();
+}
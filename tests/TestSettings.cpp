@@ -0,0 +1,5 @@
+#include "Settings.h"
+
+// Settings.cpp loads settings.json from the Nexus addon directory and is not
+// part of the portable core.  GW2Api only reads these fields.
+Settings g_Settings;
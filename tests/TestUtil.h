@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdio>
+#include <chrono>
+
+// ── Minimal checks for the test executables ───────────────────────────────────
+// CHECK reports a failure and carries on, so one run shows every broken
+// expectation; main() returns TestUtil::Result().  Unlike assert it stays
+// active in release builds.
+namespace TestUtil
+{
+    inline int& Failures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline void Fail(const char* file, int line, const char* expr)
+    {
+        fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expr);
+        ++Failures();
+    }
+
+    inline int Result()
+    {
+        if (Failures() == 0) { printf("OK\n"); return 0; }
+        fprintf(stderr, "%d check(s) failed\n", Failures());
+        return 1;
+    }
+
+    inline double MsSince(std::chrono::steady_clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+    }
+}
+
+#define CHECK(expr) \
+    do { if (!(expr)) TestUtil::Fail(__FILE__, __LINE__, #expr); } while (0)